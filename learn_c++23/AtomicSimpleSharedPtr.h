@@ -0,0 +1,88 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___ATOMICSIMPLESHAREDPTR_H
+#define LEARNC___ATOMICSIMPLESHAREDPTR_H
+#include <atomic>
+#include <thread>
+#include <utility>
+#include "SimpleSharedPtr.h"
+
+// 可被多个线程同时读写的 SimpleSharedPtr 持有者（类似 std::atomic<std::shared_ptr<T>>）
+// 典型用法：一个线程 store 新版本的配置，其他线程 load 出来各自使用。
+// 内部用一个自旋锁保护指针和控制块这两个字，临界区里只有一次计数增减和两次指针拷贝，
+// 旧对象的释放（可能触发析构）放在锁外进行。
+template <typename T>
+class AtomicSimpleSharedPtr {
+public:
+    AtomicSimpleSharedPtr() = default;
+    explicit AtomicSimpleSharedPtr(SimpleSharedPtr<T> desired) : value(std::move(desired)){}
+    AtomicSimpleSharedPtr(const AtomicSimpleSharedPtr & other) = delete;
+    AtomicSimpleSharedPtr & operator = (const AtomicSimpleSharedPtr & other) = delete;
+
+    // 返回当前值的一份拷贝（引用计数 +1）
+    SimpleSharedPtr<T> load() const{
+        Guard guard(locked);
+        return value;
+    }
+    void store(SimpleSharedPtr<T> desired){
+        exchange(std::move(desired));
+    }
+    // 换入 desired，返回旧值
+    SimpleSharedPtr<T> exchange(SimpleSharedPtr<T> desired){
+        {
+            Guard guard(locked);
+            std::swap(value, desired);
+        }
+        return desired;
+    }
+    // 当前值与 expected 指向同一个对象时换成 desired 并返回 true；
+    // 否则把当前值写回 expected 并返回 false
+    bool compare_exchange_strong(SimpleSharedPtr<T> & expected, SimpleSharedPtr<T> desired){
+        SimpleSharedPtr<T> old; // 被替换下来的值在锁外释放
+        bool success;
+        {
+            Guard guard(locked);
+            success = value.get() == expected.get();
+            if(success){
+                old = std::move(value);
+                value = std::move(desired);
+            } else {
+                old = std::move(expected);
+                expected = value;
+            }
+        }
+        return success;
+    }
+
+private:
+    mutable std::atomic<bool> locked{false};
+    SimpleSharedPtr<T> value;
+
+    // 自旋锁：先只读等待锁空闲（不写缓存行），再尝试 exchange 抢锁
+    class Guard{
+    public:
+        explicit Guard(std::atomic<bool> & flag) : flag(flag){
+            while(flag.exchange(true, std::memory_order_acquire)){
+                int spins = 0;
+                while(flag.load(std::memory_order_relaxed)){
+                    if(++spins == 64){
+                        std::this_thread::yield();
+                        spins = 0;
+                    }
+                }
+            }
+        }
+        ~Guard(){
+            flag.store(false, std::memory_order_release);
+        }
+        Guard(const Guard & other) = delete;
+        Guard & operator = (const Guard & other) = delete;
+    private:
+        std::atomic<bool> & flag;
+    };
+};
+
+
+#endif //LEARNC___ATOMICSIMPLESHAREDPTR_H
@@ -0,0 +1,126 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___SIMPLEINTRUSIVEPTR_H
+#define LEARNC___SIMPLEINTRUSIVEPTR_H
+#include <atomic>
+#include <utility>
+
+// 侵入式引用计数的基类，计数直接放在对象里，不需要单独的控制块
+// 用 CRTP 得到派生类类型，计数归零时 delete 派生类指针，不需要虚析构函数。
+// 计数的内存序与 SimpleSharedPtr 相同：增加 relaxed，减少 acq_rel。
+template <typename Derived>
+class RefCounted {
+public:
+    void add_ref() const{
+        ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    void release_ref() const{
+        if(ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            delete static_cast<const Derived *>(this);
+        }
+    }
+    int use_count() const{
+        return ref_count.load(std::memory_order_relaxed);
+    }
+
+protected:
+    RefCounted() : ref_count(0){}
+    // 拷贝出来的新对象还没有任何引用，计数不随之拷贝
+    RefCounted(const RefCounted &) : ref_count(0){}
+    RefCounted & operator = (const RefCounted &){
+        return *this;
+    }
+    ~RefCounted() = default;
+
+private:
+    mutable std::atomic<int> ref_count;
+};
+
+// 侵入式引用计数指针，接口与 SimpleSharedPtr 相同（拷贝/移动/reset/get/use_count）
+// T 需要提供 add_ref() 和 release_ref()（继承 RefCounted，或自己嵌入计数实现这两个函数），
+// 指针本身只有一个字，拷贝时直接修改对象里的计数，没有控制块，也没有额外的分配。
+// 由于计数在对象里，同一个裸指针可以随时再包装成 SimpleIntrusivePtr 而不会重复释放。
+template <typename T>
+class SimpleIntrusivePtr {
+private:
+    T *ptr;
+    void release(){
+        if(ptr){
+            ptr->release_ref();
+            ptr = nullptr;
+        }
+    }
+public:
+    SimpleIntrusivePtr() : ptr(nullptr){}
+    // 接管 p 并把计数加 1；new 出来的 RefCounted 对象计数从 0 开始
+    explicit SimpleIntrusivePtr(T *p) : ptr(p){
+        if(ptr){
+            ptr->add_ref();
+        }
+    }
+    ~SimpleIntrusivePtr(){
+        release();
+    }
+
+    SimpleIntrusivePtr(const SimpleIntrusivePtr & s) : ptr(s.ptr){
+        if(ptr){
+            ptr->add_ref();
+        }
+    }
+    SimpleIntrusivePtr & operator = (const SimpleIntrusivePtr & s){
+        if(this != &s){
+            // 先加后减，s 和 *this 指向同一个对象时也不会提前释放
+            if(s.ptr){
+                s.ptr->add_ref();
+            }
+            release();
+            ptr = s.ptr;
+        }
+        return *this;
+    }
+    SimpleIntrusivePtr(SimpleIntrusivePtr && other) noexcept : ptr(other.ptr){
+        other.ptr = nullptr;
+    }
+    SimpleIntrusivePtr & operator = (SimpleIntrusivePtr && other) noexcept{
+        if(this != &other){
+            release();
+            ptr = other.ptr;
+            other.ptr = nullptr;
+        }
+        return *this;
+    }
+
+    T * operator -> () const {
+        return ptr;
+    }
+    T & operator * () const {
+        return *ptr;
+    }
+    T * get() const{
+        return ptr;
+    }
+    int use_count() const{
+        return ptr ? ptr->use_count() : 0;
+    }
+    explicit operator bool() const{
+        return ptr != nullptr;
+    }
+    void reset(T *p = nullptr){
+        if(p){
+            p->add_ref();
+        }
+        release();
+        ptr = p;
+    }
+};
+
+// 与 make_simple_shared 对应：对象本身就带着计数，一次分配
+template <typename T, typename... Args>
+SimpleIntrusivePtr<T> make_simple_intrusive(Args&&... args){
+    return SimpleIntrusivePtr<T>(new T(std::forward<Args>(args)...));
+}
+
+
+#endif //LEARNC___SIMPLEINTRUSIVEPTR_H
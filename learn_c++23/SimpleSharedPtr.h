@@ -4,13 +4,98 @@
 
 #ifndef LEARNC___SIMPLESHAREDPTR_H
 #define LEARNC___SIMPLESHAREDPTR_H
+#include <atomic>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 
+// 引用计数是原子的，不同线程可以同时拷贝、销毁指向同一对象的 SimpleSharedPtr
+// （同一个 SimpleSharedPtr 对象本身不能被多个线程同时修改，那种场景用 AtomicSimpleSharedPtr）
+// 增加计数用 relaxed：能拷贝说明手里已经有一个引用，对象不可能在此期间被释放；
+// 减少计数用 acq_rel：release 保证本线程对对象的写在释放前可见，
+// 减到 0 的线程 acquire 后再 delete，看得到其他线程的全部写入。
+// 控制块只负责计数，计数归零后怎样销毁对象、怎样释放自己由子类决定
+// ref_count：强引用个数，归零时销毁对象（dispose）
+// weak_count：弱引用个数，所有强引用合起来再算 1 个，归零时释放控制块（destroy）
+// 这样只要还有 SimpleWeakPtr，控制块就还在，lock() 能安全地读到 ref_count 为 0。
 struct ControlBlock{
-    int ref_count;
-    ControlBlock() :ref_count(1){}
+    std::atomic<int> ref_count;
+    std::atomic<int> weak_count;
+    ControlBlock() :ref_count(1), weak_count(1){}
+    virtual ~ControlBlock() = default;
+    virtual void dispose() = 0; // 销毁被管理的对象
+    virtual void destroy() = 0; // 释放控制块自身
+
+    void add_ref(){
+        ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    void release_ref(){
+        if(ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            dispose();
+            release_weak();
+        }
+    }
+    void add_weak(){
+        weak_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    void release_weak(){
+        if(weak_count.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            destroy();
+        }
+    }
+    // 强引用不为 0 时加 1 并返回 true，供 SimpleWeakPtr::lock 使用
+    bool try_add_ref(){
+        int count = ref_count.load(std::memory_order_relaxed);
+        while(count != 0){
+            if(ref_count.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed)){
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// SimpleSharedPtr(new T) 使用：对象和控制块是两次独立的分配
+// Deleter 在强引用归零时调用，类型被擦除在控制块里，SimpleSharedPtr<T> 的类型不受影响，
+// 例如对象来自 MemoryPool 时，deleter 析构对象后把内存还给池而不是 delete。
+// deleter 在释放最后一个强引用的线程上执行。
+template <typename T, typename Deleter = std::default_delete<T>>
+struct PointerControlBlock : ControlBlock{
+    T * ptr;
+    [[no_unique_address]] Deleter deleter;
+    explicit PointerControlBlock(T * p, Deleter d = Deleter()) : ptr(p), deleter(std::move(d)){}
+    void dispose() override{
+        deleter(ptr);
+    }
+    void destroy() override{
+        delete this;
+    }
+};
+
+// make_simple_shared 使用：对象直接构造在控制块内部，一次分配，计数和对象在相邻的内存中
+template <typename T>
+struct InplaceControlBlock : ControlBlock{
+    alignas(T) unsigned char storage[sizeof(T)];
+    template <typename... Args>
+    explicit InplaceControlBlock(Args&&... args){
+        new(storage) T(std::forward<Args>(args)...);
+    }
+    T * get(){
+        return std::launder(reinterpret_cast<T *>(storage));
+    }
+    void dispose() override{
+        get()->~T();
+    }
+    void destroy() override{
+        delete this;
+    }
 };
 
 
+template <typename T>
+class SimpleWeakPtr;
+
 template <typename T>
 class SimpleSharedPtr {
 private:
@@ -18,24 +103,39 @@ private:
     ControlBlock * control;
     void release(){
         if(control){
-            --control->ref_count;
-            if(control->ref_count == 0){
-                delete ptr;
-                ptr = nullptr;
-                delete control;
-                control = nullptr;
-            }
+            control->release_ref();
+            ptr = nullptr;
+            control = nullptr;
         }
     }
-public:
-    SimpleSharedPtr():ptr(nullptr),control(nullptr){}
-    explicit SimpleSharedPtr(T *p) : ptr(p){
-        if(p){
-            control = new ControlBlock();
-        }else{
-            control = nullptr;
+    // make_simple_shared 使用：控制块已经建好，引用计数为 1
+    SimpleSharedPtr(T *p, ControlBlock * c) : ptr(p), control(c){}
+    // 为 p 分配控制块，p 为空时返回 nullptr
+    // 分配失败时先调用 deleter(p) 再抛出（与 std::shared_ptr 相同），p 不会泄漏，
+    // 对象来自内存池时槽位也能还回去
+    template <typename Deleter>
+    static ControlBlock * create_control(T *p, Deleter deleter){
+        if(p == nullptr){
+            return nullptr;
+        }
+        try {
+            return new PointerControlBlock<T, Deleter>(p, std::move(deleter));
+        } catch (...) {
+            deleter(p);
+            throw;
         }
     }
+
+    template <typename U, typename... Args>
+    friend SimpleSharedPtr<U> make_simple_shared(Args&&... args);
+    friend class SimpleWeakPtr<T>;
+public:
+    SimpleSharedPtr():ptr(nullptr),control(nullptr){}
+    explicit SimpleSharedPtr(T *p) : ptr(p), control(create_control(p, std::default_delete<T>())){}
+    // 自定义删除器：引用计数归零时调用 deleter(p) 而不是 delete p
+    template <typename Deleter>
+        requires (!std::is_convertible_v<Deleter, ControlBlock *>)
+    SimpleSharedPtr(T *p, Deleter deleter) : ptr(p), control(create_control(p, std::move(deleter))){}
     ~SimpleSharedPtr(){
         if(ptr){
             release();
@@ -45,19 +145,23 @@ public:
     // 拷贝构造 s2(s1)
     SimpleSharedPtr(const SimpleSharedPtr & s) : ptr(s.ptr), control(s.control){
         if(control){
-            ++ control->ref_count;
+            control->add_ref();
         }
     }
 
     // 拷贝赋值 s2(new student()); s2 = s1;
+    // 先给 s 加计数、记下它的两个字，再释放旧对象：s 可能就属于旧对象
+    // （例如 node = node->next），先释放会在读 s 之前把它销毁
     SimpleSharedPtr & operator = (const SimpleSharedPtr &s){
         if(this != &s){
-            release();
-            ptr = s.ptr;
-            control = s.control;
-            if(control){
-                ++ control->ref_count;
+            T * new_ptr = s.ptr;
+            ControlBlock * new_control = s.control;
+            if(new_control){
+                new_control->add_ref();
             }
+            release();
+            ptr = new_ptr;
+            control = new_control;
         }
         return * this;
     }
@@ -69,13 +173,16 @@ public:
     }
 
     // 移动赋值 SimpleSharePtr s2; s2 = std::move(s1);
+    // 与拷贝赋值相同，先把 other 的内容接过来再释放旧对象
     SimpleSharedPtr & operator = (SimpleSharedPtr && other) noexcept{
         if(this != &other){
-            release();
-            ptr = other.ptr;
-            control = other.control;
+            T * new_ptr = other.ptr;
+            ControlBlock * new_control = other.control;
             other.ptr = nullptr;
             other.control = nullptr;
+            release();
+            ptr = new_ptr;
+            control = new_control;
         }
         return *this;
     }
@@ -97,22 +204,121 @@ public:
 
     //
     int use_count() const{
-        return control ? control->ref_count : 0;
+        return control ? control->ref_count.load(std::memory_order_relaxed) : 0;
     };
 
+    explicit operator bool() const{
+        return ptr != nullptr;
+    }
+
     // s2.reset(new Student());
     // s2.reset();
+    // 先建好新的控制块再释放旧对象，分配失败时 *this 保持原样
     void reset(T *p = nullptr){
+        ControlBlock * block = create_control(p, std::default_delete<T>());
         release();
         ptr = p;
-        if(p){
-            control = new ControlBlock();
-        } else {
+        control = block;
+    }
+    template <typename Deleter>
+    void reset(T *p, Deleter deleter){
+        ControlBlock * block = create_control(p, std::move(deleter));
+        release();
+        ptr = p;
+        control = block;
+    }
+
+};
+
+// 弱引用：不影响对象的生命周期，只让控制块保持存活
+// 用于打破 SimpleSharedPtr 之间的循环引用（A 持有 B、B 持有 A 时，其中一边改为弱引用），
+// 使用前用 lock() 换成 SimpleSharedPtr，对象已销毁时得到空指针。
+template <typename T>
+class SimpleWeakPtr {
+private:
+    T *ptr;
+    ControlBlock * control;
+    void release(){
+        if(control){
+            control->release_weak();
+            ptr = nullptr;
             control = nullptr;
         }
     }
+public:
+    SimpleWeakPtr() : ptr(nullptr), control(nullptr){}
+    SimpleWeakPtr(const SimpleSharedPtr<T> & s) : ptr(s.ptr), control(s.control){
+        if(control){
+            control->add_weak();
+        }
+    }
+    ~SimpleWeakPtr(){
+        release();
+    }
+    SimpleWeakPtr(const SimpleWeakPtr & other) : ptr(other.ptr), control(other.control){
+        if(control){
+            control->add_weak();
+        }
+    }
+    // 与 SimpleSharedPtr 的赋值相同，先接管 other 再释放旧的控制块
+    SimpleWeakPtr & operator = (const SimpleWeakPtr & other){
+        if(this != &other){
+            T * new_ptr = other.ptr;
+            ControlBlock * new_control = other.control;
+            if(new_control){
+                new_control->add_weak();
+            }
+            release();
+            ptr = new_ptr;
+            control = new_control;
+        }
+        return *this;
+    }
+    SimpleWeakPtr(SimpleWeakPtr && other) noexcept : ptr(other.ptr), control(other.control){
+        other.ptr = nullptr;
+        other.control = nullptr;
+    }
+    SimpleWeakPtr & operator = (SimpleWeakPtr && other) noexcept{
+        if(this != &other){
+            T * new_ptr = other.ptr;
+            ControlBlock * new_control = other.control;
+            other.ptr = nullptr;
+            other.control = nullptr;
+            release();
+            ptr = new_ptr;
+            control = new_control;
+        }
+        return *this;
+    }
+    SimpleWeakPtr & operator = (const SimpleSharedPtr<T> & s){
+        return *this = SimpleWeakPtr(s);
+    }
 
+    // 对象还活着时返回一个新的强引用，否则返回空指针；多线程下判断和加计数是一步完成的
+    SimpleSharedPtr<T> lock() const{
+        if(control && control->try_add_ref()){
+            return SimpleSharedPtr<T>(ptr, control);
+        }
+        return SimpleSharedPtr<T>();
+    }
+    bool expired() const{
+        return use_count() == 0;
+    }
+    int use_count() const{
+        return control ? control->ref_count.load(std::memory_order_relaxed) : 0;
+    }
+    void reset(){
+        release();
+    }
 };
 
+// 对象和控制块在同一次分配中创建：比 SimpleSharedPtr(new T(...)) 少一次分配，
+// 解引用时计数与对象通常在同一条或相邻的缓存行上
+template <typename T, typename... Args>
+SimpleSharedPtr<T> make_simple_shared(Args&&... args){
+    auto * block = new InplaceControlBlock<T>(std::forward<Args>(args)...);
+    return SimpleSharedPtr<T>(block->get(), block);
+}
+
 
 #endif //LEARNC___SIMPLESHAREDPTR_H
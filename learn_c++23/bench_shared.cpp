@@ -0,0 +1,189 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// 引用计数竞争：所有线程反复拷贝、销毁指向同一个对象的指针，计数所在的缓存行在核之间来回传递
+// 1. SimpleSharedPtr、SimpleIntrusivePtr 与 std::shared_ptr 的拷贝 + 析构
+// 2. AtomicSimpleSharedPtr 与 std::atomic<std::shared_ptr> 的 load，另有一个线程周期性 store
+// 3. 创建大量对象：SimpleSharedPtr(new T) 与 make_simple_shared、make_simple_intrusive、std::make_shared 的分配次数、
+//    创建耗时，以及之后按顺序解引用求和的耗时
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "SimpleSharedPtr.h"
+#include "AtomicSimpleSharedPtr.h"
+#include "SimpleIntrusivePtr.h"
+
+// 统计全局 operator new 的调用次数
+static std::atomic<long long> allocation_count(0);
+
+void * operator new(std::size_t size){
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if(void * memory = std::malloc(size == 0 ? 1 : size)){
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void * memory) noexcept{
+    std::free(memory);
+}
+void operator delete(void * memory, std::size_t) noexcept{
+    std::free(memory);
+}
+
+struct Payload{
+    long long value;
+};
+
+struct CountedPayload : RefCounted<CountedPayload>{
+    long long value;
+    explicit CountedPayload(long long value) : value(value){}
+};
+static_assert(sizeof(SimpleIntrusivePtr<CountedPayload>) == sizeof(void *));
+
+// threads 个线程各执行 fn(iterations)，返回每次操作的平均耗时（ns）
+template <typename Fn>
+static double run(int threads, long long iterations, Fn fn){
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t){
+        workers.emplace_back([&fn, iterations](){ fn(iterations); });
+    }
+    for(auto & worker : workers){
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+
+template <typename Ptr>
+static double copy_ns(int threads, long long iterations, const Ptr & shared, std::atomic<long long> & checksum){
+    return run(threads, iterations, [&shared, &checksum](long long n){
+        long long local = 0;
+        for(long long i = 0; i < n; ++i){
+            Ptr copy = shared;
+            local += copy->value;
+        }
+        checksum.fetch_add(local, std::memory_order_relaxed);
+    });
+}
+
+// 读者不断 load，写者每 1000 次换一个新对象
+template <typename Holder, typename Make>
+static double load_ns(int threads, long long iterations, Holder & holder, Make make, std::atomic<long long> & checksum){
+    std::atomic<bool> done(false);
+    std::thread writer([&](){
+        long long version = 0;
+        while(!done.load(std::memory_order_relaxed)){
+            holder.store(make(++version));
+            for(int i = 0; i < 1000 && !done.load(std::memory_order_relaxed); ++i){
+                std::this_thread::yield();
+            }
+        }
+    });
+    double ns = run(threads, iterations, [&holder, &checksum](long long n){
+        long long local = 0;
+        for(long long i = 0; i < n; ++i){
+            local += holder.load()->value;
+        }
+        checksum.fetch_add(local, std::memory_order_relaxed);
+    });
+    done.store(true);
+    writer.join();
+    return ns;
+}
+
+template <typename Fn>
+static double measure_ms(Fn && fn){
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// 创建 n 个对象后顺序解引用 rounds 遍，模拟持有大量共享对象后的读取
+template <typename Ptr, typename Make>
+static void report_make(const char * name, long long n, Make make, long long & sum){
+    std::vector<Ptr> objects;
+    objects.reserve(n);
+    long long before = allocation_count.load();
+    double create_ms = measure_ms([&](){
+        for(long long i = 0; i < n; ++i){
+            objects.push_back(make(i));
+        }
+    });
+    long long allocations = allocation_count.load() - before;
+    double deref_ms = measure_ms([&](){
+        for(int round = 0; round < 10; ++round){
+            for(auto & object : objects){
+                sum += object->value;
+            }
+        }
+    });
+    double destroy_ms = measure_ms([&](){ objects.clear(); });
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(14) << static_cast<double>(allocations) / static_cast<double>(n)
+              << std::setw(12) << create_ms << std::setw(12) << deref_ms << std::setw(12) << destroy_ms << std::endl;
+}
+
+int main(int argc, char * argv[]){
+    long long iterations = argc > 1 ? std::atoll(argv[1]) : 2000000;
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2]))
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<long long> checksum(0);
+    SimpleSharedPtr<Payload> simple(new Payload{1});
+    std::shared_ptr<Payload> standard = std::make_shared<Payload>(Payload{1});
+    SimpleIntrusivePtr<CountedPayload> intrusive = make_simple_intrusive<CountedPayload>(1);
+
+    std::cout << "copy + destroy, " << iterations << " per thread (ns per op, wall clock)" << std::endl;
+    std::cout << "threads   SimpleSharedPtr   std::shared_ptr   SimpleIntrusivePtr" << std::endl;
+    for(unsigned threads = 1; threads <= max_threads; threads *= 2){
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(18) << copy_ns(static_cast<int>(threads), iterations, simple, checksum)
+                  << std::setw(18) << copy_ns(static_cast<int>(threads), iterations, standard, checksum)
+                  << std::setw(21) << copy_ns(static_cast<int>(threads), iterations, intrusive, checksum) << std::endl;
+    }
+
+    AtomicSimpleSharedPtr<Payload> simple_holder(SimpleSharedPtr<Payload>(new Payload{0}));
+    auto make_simple = [](long long version){ return SimpleSharedPtr<Payload>(new Payload{version}); };
+    std::cout << "load with a concurrent writer (ns per op, wall clock)" << std::endl;
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<Payload>> standard_holder(std::make_shared<Payload>(Payload{0}));
+    auto make_standard = [](long long version){ return std::make_shared<Payload>(Payload{version}); };
+    std::cout << "threads   AtomicSimpleSharedPtr   atomic<shared_ptr>" << std::endl;
+#else
+    std::cout << "threads   AtomicSimpleSharedPtr" << std::endl;
+#endif
+    for(unsigned threads = 1; threads <= max_threads; threads *= 2){
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(1)
+                  << std::setw(24) << load_ns(static_cast<int>(threads), iterations, simple_holder, make_simple, checksum);
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::cout << std::setw(21) << load_ns(static_cast<int>(threads), iterations, standard_holder, make_standard, checksum);
+#endif
+        std::cout << std::endl;
+    }
+
+    long long n = argc > 3 ? std::atoll(argv[3]) : 2000000;
+    long long sum = 0;
+    std::cout << "create " << n << " objects, then deref 10 rounds (ms)" << std::endl;
+    std::cout << std::left << std::setw(28) << "construction" << std::right
+              << std::setw(14) << "allocs/obj" << std::setw(12) << "create" << std::setw(12) << "deref"
+              << std::setw(12) << "destroy" << std::endl;
+    report_make<SimpleSharedPtr<Payload>>("SimpleSharedPtr(new T)", n,
+        [](long long i){ return SimpleSharedPtr<Payload>(new Payload{i}); }, sum);
+    report_make<SimpleSharedPtr<Payload>>("make_simple_shared", n,
+        [](long long i){ return make_simple_shared<Payload>(Payload{i}); }, sum);
+    report_make<SimpleIntrusivePtr<CountedPayload>>("make_simple_intrusive", n,
+        [](long long i){ return make_simple_intrusive<CountedPayload>(i); }, sum);
+    report_make<std::shared_ptr<Payload>>("std::make_shared", n,
+        [](long long i){ return std::make_shared<Payload>(Payload{i}); }, sum);
+    checksum.fetch_add(sum);
+    std::cout << "checksum " << checksum.load() << std::endl;
+    return 0;
+}
@@ -4,7 +4,39 @@
 
 #include <iostream>
 #include "SimpleSharedPtr.h"
+#include "AtomicSimpleSharedPtr.h"
+#include "SimpleIntrusivePtr.h"
+#include <thread>
+#include <vector>
 #include "../learn_c++22/Student.h"
+#include "../exercise2/MemoryPool.h"
+
+// 互相引用的两个对象：B 对 A 只持有弱引用，离开作用域时两者都能被释放
+class PairB;
+class PairA{
+public:
+    SimpleSharedPtr<PairB> ptrB;
+    ~PairA(){
+        std::cout << "~PairA()" << std::endl;
+    }
+};
+class PairB{
+public:
+    SimpleWeakPtr<PairA> ptrA;
+    ~PairB(){
+        std::cout << "~PairB()" << std::endl;
+    }
+};
+
+// 计数放在对象里的学生记录
+class CountedStudent : public RefCounted<CountedStudent>{
+public:
+    explicit CountedStudent(std::string name) : name(std::move(name)){}
+    ~CountedStudent(){
+        std::cout << "~CountedStudent() " << name << std::endl;
+    }
+    std::string name;
+};
 
 int main(){
 
@@ -33,5 +65,68 @@ int main(){
     std::cout << "Ptr3 use_count : " << ptr3.use_count() << std::endl;
     std::cout << "Ptr1 use_count : " << ptr1.use_count() << std::endl;
 
+    std::cout << "-----------------" << std::endl;
+    // 引用计数是原子的：多个线程同时拷贝同一个对象的指针
+    std::vector<std::thread> workers;
+    for(int t = 0; t < 4; ++t){
+        workers.emplace_back([&ptr2](){
+            for(int i = 0; i < 10000; ++i){
+                SimpleSharedPtr<Student> copy(ptr2);
+            }
+        });
+    }
+    for(auto & worker : workers){
+        worker.join();
+    }
+    std::cout << "Ptr2 use_count after threads : " << ptr2.use_count() << std::endl;
+
+    // 多线程共享的“当前学生”：一个线程换新对象，其他线程读取
+    AtomicSimpleSharedPtr<Student> current(ptr2);
+    current.store(SimpleSharedPtr<Student>(new Student("Amy", 21)));
+    SimpleSharedPtr<Student> loaded = current.load();
+    std::cout << "current : " << loaded->name << ", Ptr2 use_count : " << ptr2.use_count() << std::endl;
+
+    // 对象和控制块一次分配
+    SimpleSharedPtr<Student> ptr4 = make_simple_shared<Student>("Lily", 19);
+    SimpleSharedPtr<Student> ptr5 = ptr4;
+    std::cout << "made : " << ptr5->name << ", Ptr4 use_count : " << ptr4.use_count() << std::endl;
+
+    std::cout << "-----------------" << std::endl;
+    // 弱引用打破循环引用
+    SimpleWeakPtr<PairA> watch;
+    {
+        SimpleSharedPtr<PairA> a = make_simple_shared<PairA>();
+        SimpleSharedPtr<PairB> b = make_simple_shared<PairB>();
+        a->ptrB = b;
+        b->ptrA = a;
+        watch = a;
+        std::cout << "a use_count : " << a.use_count() << ", b use_count : " << b.use_count()
+                  << ", locked : " << (watch.lock() ? "yes" : "no") << std::endl;
+    }
+    std::cout << "after scope, expired : " << watch.expired() << std::endl;
+
+    // 自定义删除器：对象来自 MemoryPool，引用计数归零后析构并把内存还给池
+    MemoryPool pool(sizeof(Student), 4);
+    auto pool_deleter = [&pool](Student * s){
+        s->~Student();
+        pool.deallocate(s);
+        std::cout << "Student returned to pool" << std::endl;
+    };
+    {
+        SimpleSharedPtr<Student> pooled(new(pool.allocate()) Student("Bob", 22), pool_deleter);
+        SimpleSharedPtr<Student> pooled_copy = pooled;
+        std::cout << "pooled : " << pooled_copy->name << ", use_count : " << pooled.use_count() << std::endl;
+    }
+
+    // 侵入式引用计数：指针只有一个字，没有控制块
+    SimpleIntrusivePtr<CountedStudent> ptr6 = make_simple_intrusive<CountedStudent>("Eve");
+    SimpleIntrusivePtr<CountedStudent> ptr7 = ptr6;
+    SimpleIntrusivePtr<CountedStudent> ptr8(ptr6.get()); // 同一个裸指针再包装一次也安全
+    std::cout << "intrusive : " << ptr7->name << ", use_count : " << ptr6.use_count()
+              << ", sizeof : " << sizeof(ptr6) << std::endl;
+    ptr6.reset();
+    ptr7.reset();
+    ptr8.reset();
+
     return 0;
 }
\ No newline at end of file
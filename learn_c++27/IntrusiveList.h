@@ -0,0 +1,205 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___INTRUSIVELIST_H
+#define LEARNC___INTRUSIVELIST_H
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+
+// 侵入式链表的挂钩：元素类型公有继承 ListHook，前后指针直接放在元素对象里
+// 同一个对象要同时挂在多个链表上时，用不同的 Tag 继承多个 ListHook<Tag>
+// 挂钩析构时会自动从所在链表中摘下，对象先于链表销毁也是安全的；
+// 拷贝对象时挂钩不会被拷贝，新对象处于未挂入任何链表的状态。
+template <typename Tag = void>
+struct ListHook{
+    ListHook * prev;
+    ListHook * next;
+
+    ListHook() : prev(nullptr), next(nullptr){}
+    ListHook(const ListHook &) : prev(nullptr), next(nullptr){}
+    ListHook & operator=(const ListHook &){
+        return *this;
+    }
+    ~ListHook(){
+        unlink();
+    }
+
+    bool is_linked() const{
+        return next != nullptr;
+    }
+    // 只凭对象自身就能 O(1) 从所在链表中摘下，未挂入链表时什么也不做
+    void unlink(){
+        if(next != nullptr){
+            prev->next = next;
+            next->prev = prev;
+            prev = nullptr;
+            next = nullptr;
+        }
+    }
+};
+
+// 侵入式双向链表，不拥有元素：insert/erase 只改指针，永远不分配内存
+// 元素的生命周期由调用方管理（通常来自对象池），链表析构时只摘下元素，不销毁它们。
+// 由于元素可以自行 unlink，链表无法维护元素个数，size() 为 O(n)。
+template <typename T, typename Tag = void>
+class IntrusiveList{
+public:
+    using hook_type = ListHook<Tag>;
+
+    class Iterator{
+    public:
+        using self_type = Iterator;
+        using value_type = T;
+        using reference = T&;
+        using pointer = T*;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator(hook_type * ptr = nullptr) : hook_ptr(ptr){}
+        reference operator* () const{return *to_value(hook_ptr);}
+        pointer operator-> () const{return to_value(hook_ptr);}
+        self_type & operator++(){
+            hook_ptr = hook_ptr->next;
+            return *this;
+        }
+        self_type operator++(int){
+            self_type temp = *this;
+            ++(*this);
+            return temp;
+        }
+        self_type & operator--(){
+            hook_ptr = hook_ptr->prev;
+            return *this;
+        }
+        self_type operator--(int){
+            self_type temp = *this;
+            --(*this);
+            return temp;
+        }
+        bool operator==(const self_type & other) const{
+            return hook_ptr == other.hook_ptr;
+        }
+        bool operator!=(const self_type & other) const{
+            return hook_ptr != other.hook_ptr;
+        }
+    private:
+        hook_type * hook_ptr;
+        friend class IntrusiveList;
+    };
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    IntrusiveList(){
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
+    }
+    ~IntrusiveList(){
+        clear();
+    }
+    IntrusiveList(const IntrusiveList & other) = delete;
+    IntrusiveList & operator=(const IntrusiveList & other) = delete;
+
+    // 把 value 挂到 pos 之前，value 不能已经在某个链表中
+    iterator insert(iterator pos, T & value){
+        hook_type * hook = to_hook(&value);
+        hook->next = pos.hook_ptr;
+        hook->prev = pos.hook_ptr->prev;
+        pos.hook_ptr->prev->next = hook;
+        pos.hook_ptr->prev = hook;
+        return iterator(hook);
+    }
+    // 摘下 pos 指向的元素（不销毁），返回下一个位置
+    iterator erase(iterator pos){
+        if(pos.hook_ptr == &sentinel){
+            return end();
+        }
+        iterator ret(pos.hook_ptr->next);
+        pos.hook_ptr->unlink();
+        return ret;
+    }
+    void push_front(T & value){
+        insert(begin(), value);
+    }
+    void push_back(T & value){
+        insert(end(), value);
+    }
+    void pop_front(){
+        if(!empty()){
+            erase(begin());
+        }
+    }
+    void pop_back(){
+        if(!empty()){
+            erase(iterator(sentinel.prev));
+        }
+    }
+
+    T & front(){
+        return *to_value(sentinel.next);
+    }
+    T & back(){
+        return *to_value(sentinel.prev);
+    }
+    bool empty() const{
+        return sentinel.next == &sentinel;
+    }
+    size_t size() const{
+        size_t count = 0;
+        for(const hook_type * current = sentinel.next; current != &sentinel; current = current->next){
+            count++;
+        }
+        return count;
+    }
+
+    // 由元素得到指向它的迭代器，O(1)
+    static iterator iterator_to(T & value){
+        return iterator(to_hook(&value));
+    }
+    // 从所在链表中摘下 value，不需要知道是哪个链表
+    static void remove(T & value){
+        to_hook(&value)->unlink();
+    }
+
+    void print(){
+        for(auto it = begin(); it != end(); ++it){
+            std::cout << *it << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    iterator begin(){
+        return iterator(sentinel.next);
+    }
+    iterator end(){
+        return iterator(&sentinel);
+    }
+
+    // 摘下所有元素，元素本身不受影响
+    void clear(){
+        hook_type * cur = sentinel.next;
+        while(cur != &sentinel){
+            hook_type * next = cur->next;
+            cur->prev = nullptr;
+            cur->next = nullptr;
+            cur = next;
+        }
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
+    }
+
+private:
+    // 哨兵不属于任何元素，只借用挂钩的前后指针；析构前由 clear 置回自环，不会误摘
+    hook_type sentinel;
+
+    static hook_type * to_hook(T * value){
+        return static_cast<hook_type *>(value);
+    }
+    static T * to_value(hook_type * hook){
+        return static_cast<T *>(hook);
+    }
+};
+
+
+#endif //LEARNC___INTRUSIVELIST_H
@@ -0,0 +1,5 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#include "LRUCache.h"
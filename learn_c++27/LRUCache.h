@@ -0,0 +1,288 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___LRUCACHE_H
+#define LEARNC___LRUCACHE_H
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "List.h"
+#include "../learn_c++30/FlatHashMap.h"
+
+// 默认每个条目占 1 个单位，容量即条目个数
+struct UnitCharge{
+    template <typename Key, typename Value>
+    std::size_t operator()(const Key &, const Value &) const{
+        return 1;
+    }
+};
+
+// LRU 缓存：List 按访问时间排序（表头最新），FlatHashMap 从键索引到链表节点
+// get/put/erase/淘汰都是 O(1)：命中时用 splice 把节点移到表头，不重新分配节点；
+// List 的节点来自 NodePool，缓存装满之后淘汰和插入都在复用节点。
+// Charge(key, value) 给出每个条目占用的容量，默认 UnitCharge 即按条目数计，
+// 传入按字节计算的函数对象就得到按字节计的容量。
+// 单个条目超过整个容量时不会放入（put 返回 false），也不会因此淘汰其他条目。
+// 不是线程安全的，多线程使用 ShardedLRUCache。
+template <typename Key, typename Value, typename Charge = UnitCharge, typename Hash = std::hash<Key>>
+class LRUCache{
+private:
+    struct Entry{
+        Key key;
+        Value value;
+        std::size_t charge;
+    };
+    using list_type = List<Entry, NodePool<Node<Entry>>>;
+    using list_iterator = typename list_type::iterator;
+
+public:
+    // 因容量不足被淘汰时调用，显式 erase 和 clear 不调用
+    using eviction_callback = std::function<void(const Key &, Value &)>;
+
+    explicit LRUCache(std::size_t capacity, const Charge & charge = Charge(), const Hash & hash = Hash()) :
+        index(hash), max_usage(capacity), usage_sum(0),
+        hit_count(0), miss_count(0), eviction_count(0), charge_of(charge){}
+    LRUCache(const LRUCache & other) = delete;
+    LRUCache & operator=(const LRUCache & other) = delete;
+
+    // 查找并把条目标记为最近使用，未命中时返回 nullptr
+    // 返回的指针在下一次 put/erase 之前有效
+    Value * get(const Key & key){
+        list_iterator * pos = index.find(key);
+        if(pos == nullptr){
+            ++miss_count;
+            return nullptr;
+        }
+        ++hit_count;
+        entries.splice(entries.begin(), entries, *pos);
+        return &(*pos)->value;
+    }
+    // 只检查是否存在，不影响访问顺序和命中统计
+    bool contains(const Key & key) const{
+        return index.find(key) != nullptr;
+    }
+    // 插入或覆盖，条目成为最近使用的，之后按需从表尾淘汰
+    // 条目的 charge 超过整个容量时返回 false：不放入，同键的旧条目也被删除（不调用淘汰回调）
+    bool put(const Key & key, const Value & value){
+        return put_impl(key, value);
+    }
+    bool put(const Key & key, Value && value){
+        return put_impl(key, std::move(value));
+    }
+    bool erase(const Key & key){
+        list_iterator * pos = index.find(key);
+        if(pos == nullptr){
+            return false;
+        }
+        usage_sum -= (*pos)->charge;
+        entries.erase(*pos);
+        index.erase(key);
+        return true;
+    }
+    void clear(){
+        entries.clear();
+        index.clear();
+        usage_sum = 0;
+    }
+
+    void set_eviction_callback(eviction_callback callback){
+        on_evict = std::move(callback);
+    }
+
+    [[nodiscard]] std::size_t size() const{
+        return entries.size();
+    }
+    bool empty() const{
+        return entries.empty();
+    }
+    // 当前占用的容量（Charge 之和）
+    std::size_t usage() const{
+        return usage_sum;
+    }
+    std::size_t capacity() const{
+        return max_usage;
+    }
+    std::uint64_t hits() const{
+        return hit_count;
+    }
+    std::uint64_t misses() const{
+        return miss_count;
+    }
+    std::uint64_t evictions() const{
+        return eviction_count;
+    }
+
+private:
+    list_type entries;
+    FlatHashMap<Key, list_iterator, Hash> index;
+    std::size_t max_usage;
+    std::size_t usage_sum;
+    std::uint64_t hit_count;
+    std::uint64_t miss_count;
+    std::uint64_t eviction_count;
+    [[no_unique_address]] Charge charge_of;
+    eviction_callback on_evict;
+
+    template <typename V>
+    bool put_impl(const Key & key, V && value){
+        std::size_t charge = charge_of(key, value);
+        if(charge > max_usage){
+            // 先于任何修改检查，否则新条目会把其他条目全部挤出去之后再被淘汰
+            erase(key);
+            return false;
+        }
+        if(list_iterator * pos = index.find(key)){
+            usage_sum = usage_sum - (*pos)->charge + charge;
+            (*pos)->value = std::forward<V>(value);
+            (*pos)->charge = charge;
+            entries.splice(entries.begin(), entries, *pos);
+        } else {
+            entries.emplace(entries.begin(), Entry{key, std::forward<V>(value), charge});
+            try {
+                index.insert(key, entries.begin());
+            } catch (...) {
+                // 索引扩容失败时撤销链表中的新条目，两者保持一致
+                entries.pop_front();
+                throw;
+            }
+            usage_sum += charge;
+        }
+        evict();
+        return true;
+    }
+    void evict(){
+        while(usage_sum > max_usage && !entries.empty()){
+            Entry & victim = entries.back();
+            if(on_evict){
+                on_evict(victim.key, victim.value);
+            }
+            usage_sum -= victim.charge;
+            ++eviction_count;
+            index.erase(victim.key);
+            entries.pop_back();
+        }
+    }
+};
+
+// 线程安全的分片 LRU：按键的哈希分到 shard_count 个独立的 LRUCache，各自一把锁
+// 不同分片上的操作互不阻塞；每个分片的容量为总容量 / shard_count，
+// 淘汰只在分片内部按 LRU 进行，整体上是近似 LRU。
+// 淘汰回调在持有分片锁时调用，回调里不能再访问同一个缓存。
+template <typename Key, typename Value, typename Charge = UnitCharge, typename Hash = std::hash<Key>>
+class ShardedLRUCache{
+private:
+    using cache_type = LRUCache<Key, Value, Charge, Hash>;
+    static constexpr std::size_t cache_line = 64;
+    // 每个分片独占缓存行，锁之间不发生伪共享
+    struct alignas(cache_line) Shard{
+        std::mutex mtx;
+        cache_type cache;
+        Shard(std::size_t capacity, const Charge & charge, const Hash & hash) : cache(capacity, charge, hash){}
+    };
+
+public:
+    using eviction_callback = typename cache_type::eviction_callback;
+
+    // shard_count 会向上取整到 2 的幂
+    explicit ShardedLRUCache(std::size_t capacity, std::size_t shard_count = 16,
+                             const Charge & charge = Charge(), const Hash & hash = Hash()) : hasher(hash){
+        std::size_t count = 1;
+        while(count < shard_count){
+            count *= 2;
+        }
+        shard_mask = count - 1;
+        std::size_t per_shard = (capacity + count - 1) / count;
+        for(std::size_t i = 0; i < count; ++i){
+            shards.push_back(std::make_unique<Shard>(per_shard, charge, hash));
+        }
+    }
+    ShardedLRUCache(const ShardedLRUCache & other) = delete;
+    ShardedLRUCache & operator=(const ShardedLRUCache & other) = delete;
+
+    // 返回值的拷贝，释放锁之后仍然有效
+    std::optional<Value> get(const Key & key){
+        Shard & shard = shard_of(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        if(Value * value = shard.cache.get(key)){
+            return *value;
+        }
+        return std::nullopt;
+    }
+    // 与 LRUCache::put 相同，条目超过单个分片的容量时返回 false
+    bool put(const Key & key, const Value & value){
+        Shard & shard = shard_of(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        return shard.cache.put(key, value);
+    }
+    bool put(const Key & key, Value && value){
+        Shard & shard = shard_of(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        return shard.cache.put(key, std::move(value));
+    }
+    bool erase(const Key & key){
+        Shard & shard = shard_of(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        return shard.cache.erase(key);
+    }
+    void clear(){
+        for(auto & shard : shards){
+            std::lock_guard<std::mutex> lock(shard->mtx);
+            shard->cache.clear();
+        }
+    }
+    void set_eviction_callback(const eviction_callback & callback){
+        for(auto & shard : shards){
+            std::lock_guard<std::mutex> lock(shard->mtx);
+            shard->cache.set_eviction_callback(callback);
+        }
+    }
+
+    // 以下统计逐个分片加锁累加，不是同一时刻的快照
+    std::size_t size() const{
+        return sum([](const cache_type & cache){ return static_cast<std::uint64_t>(cache.size()); });
+    }
+    std::size_t usage() const{
+        return sum([](const cache_type & cache){ return static_cast<std::uint64_t>(cache.usage()); });
+    }
+    std::uint64_t hits() const{
+        return sum([](const cache_type & cache){ return cache.hits(); });
+    }
+    std::uint64_t misses() const{
+        return sum([](const cache_type & cache){ return cache.misses(); });
+    }
+    std::uint64_t evictions() const{
+        return sum([](const cache_type & cache){ return cache.evictions(); });
+    }
+    std::size_t shard_count() const{
+        return shards.size();
+    }
+
+private:
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::size_t shard_mask;
+    Hash hasher;
+
+    // 乘法散列后取高位选分片，std::hash 对整数是恒等映射，直接取低位会分布不均
+    Shard & shard_of(const Key & key){
+        std::uint64_t h = static_cast<std::uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ull;
+        return *shards[static_cast<std::size_t>(h >> 32) & shard_mask];
+    }
+    template <typename Fn>
+    std::uint64_t sum(Fn fn) const{
+        std::uint64_t total = 0;
+        for(auto & shard : shards){
+            std::lock_guard<std::mutex> lock(shard->mtx);
+            total += fn(shard->cache);
+        }
+        return total;
+    }
+};
+
+
+#endif //LEARNC___LRUCACHE_H
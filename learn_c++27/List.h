@@ -4,17 +4,28 @@
 
 #ifndef LEARNC___LIST_H
 #define LEARNC___LIST_H
+#include <functional>
 #include <iostream>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "../learn_c++30/NodePool.h"
+
+// 只有前后指针的链表节点，哨兵节点只需要这一部分，不用构造 T
+struct NodeBase{
+    NodeBase * prev;
+    NodeBase * next;
+    NodeBase() : prev(nullptr), next(nullptr){}
+};
 
 template <typename T>
-struct Node{
+struct Node : NodeBase{
     T data;
-    Node * prev;
-    Node * next;
-    Node(const T & value = T()) : data(value), prev(nullptr), next(nullptr){}
+    template <typename... Args>
+    explicit Node(Args&&... args) : data(std::forward<Args>(args)...){}
 };
 
-template <typename T>
+template <typename T, typename Alloc = NewDeleteAllocator<Node<T>>>
 class List;
 
 template <typename T>
@@ -27,9 +38,9 @@ public:
     using iterator_category = std::bidirectional_iterator_tag;
     using difference_type = std::ptrdiff_t;
 
-    Iterator(Node<T> * ptr = nullptr) : node_ptr(ptr){}
-    reference operator* ()const{return node_ptr->data;}
-    pointer operator-> () const{return &(node_ptr->data); /* 先去data 再取data的地址进行返回 */ }
+    Iterator(NodeBase * ptr = nullptr) : node_ptr(ptr){}
+    reference operator* ()const{return static_cast<Node<T> *>(node_ptr)->data;}
+    pointer operator-> () const{return &(static_cast<Node<T> *>(node_ptr)->data); /* 先去data 再取data的地址进行返回 */ }
     self_type & operator++(){
         if(node_ptr){
             node_ptr = node_ptr->next;
@@ -60,54 +71,84 @@ public:
     }
 
 private:
-    Node<T> * node_ptr;
-    friend class List<T>;
+    NodeBase * node_ptr;
+    template <typename, typename>
+    friend class List;
 };
 
-template <typename T>
+// 双向循环链表，sentinel 同时充当头哨兵和尾哨兵，直接放在 List 对象里，不需要单独分配
+// 节点内存由 Alloc 提供，需要有 void * allocate()、void deallocate(void *)，
+// 以及表示“能否回收对方分配的节点”的 operator==。
+// 默认使用 NewDeleteAllocator，任意两个 List 都能互相接收节点。
+// 需要复用节点时传入 NodePool<Node<T>>（每个 List 独占一个池）：erase 掉的节点回到空闲链表，
+// 下一次 insert 直接复用，链表规模稳定之后插入删除不再访问全局堆，池中的 slab 在 List 析构时统一释放；
+// 多个 List 既要复用节点又要互相 splice 时，用指向同一个池的 NodePoolRef。
+// 元素个数由 node_count 维护，size() 为 O(1)。
+// splice 在两个 List 之间移动节点时，节点之后由目标 List 的 Alloc 回收，
+// 因此要求两边的 Alloc 相等（NewDeleteAllocator，或指向同一个池的 NodePoolRef）；
+// 不相等时（例如各自独立的 NodePool）抛出 std::invalid_argument，两个链表都不被修改。
+template <typename T, typename Alloc>
 class List{
 public:
     using iterator = Iterator<T>;
     using const_iterator = Iterator<T>;
-    List(){
-        head = new Node<T>();
-        tail = new Node<T>();
-        head->next = tail;
-        tail->prev = head;
+    using node_type = Node<T>;
+    using allocator_type = Alloc;
+
+    List() : node_count(0){
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
+    }
+    explicit List(const Alloc & allocator) : node_count(0), alloc(allocator){
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
     }
     ~List(){
         clear();
-        delete head;
-        delete tail;
     }
     List(const List & other) = delete;
     List & operator=(const List & other) = delete;
 
     iterator insert(iterator pos, const T & value){
-        Node<T> * node = pos.node_ptr;
-        Node<T> * new_node = new Node<T>(value);
+        return emplace(pos, value);
+    }
+    iterator insert(iterator pos, T && value){
+        return emplace(pos, std::move(value));
+    }
+    // 在 pos 之前原地构造元素
+    template <typename... Args>
+    iterator emplace(iterator pos, Args&&... args){
+        NodeBase * new_node = create_node(std::forward<Args>(args)...);
         new_node->next = pos.node_ptr;
         new_node->prev = pos.node_ptr->prev;
         pos.node_ptr->prev->next = new_node;
         pos.node_ptr->prev = new_node;
+        ++node_count;
         return iterator(new_node);
     }
     iterator erase(iterator pos){
-        if(pos.node_ptr == head || pos.node_ptr == tail){
-            return iterator(tail);
+        if(pos.node_ptr == &sentinel){
+            return end();
         }
         iterator ret(pos.node_ptr->next);
         pos.node_ptr->prev->next = pos.node_ptr->next;
         pos.node_ptr->next->prev = pos.node_ptr->prev;
-        delete pos.node_ptr;
-        return iterator(ret);
+        destroy_node(pos.node_ptr);
+        --node_count;
+        return ret;
     }
     void push_front(const T & value){
         insert(begin(), value);
     }
+    void push_front(T && value){
+        insert(begin(), std::move(value));
+    }
     void push_back(const T & value){
         insert(end(), value);
     }
+    void push_back(T && value){
+        insert(end(), std::move(value));
+    }
 
     void pop_front(){
         if(!empty()){
@@ -123,65 +164,293 @@ public:
     }
 
     T & front(){
-        return head->next->data;
+        return static_cast<Node<T> *>(sentinel.next)->data;
     }
 
     T & back(){
-        return tail->prev->data;
+        return static_cast<Node<T> *>(sentinel.prev)->data;
     }
 
     bool empty() const{
-        return head->next == tail;
+        return sentinel.next == &sentinel;
     }
 
     size_t size()const{
-        size_t count = 0;
-        for(auto it = begin(); it != end(); ++it){
-            count++;
-        }
-        return count;
+        return node_count;
     }
 
-    void remove(const T& value){
+    // 删除所有等于 value 的元素，返回删除的个数
+    // value 可能就是链表中的某个元素，该元素放到最后再删，避免之后的比较引用已被销毁的对象
+    size_t remove(const T& value){
+        size_t removed = 0;
+        NodeBase * deferred = nullptr;
+        for(NodeBase * cur = sentinel.next; cur != &sentinel;){
+            NodeBase * next = cur->next;
+            if(value_of(cur) == value){
+                if(&value_of(cur) == &value){
+                    deferred = cur;
+                } else {
+                    erase(iterator(cur));
+                    ++removed;
+                }
+            }
+            cur = next;
+        }
+        if(deferred != nullptr){
+            erase(iterator(deferred));
+            ++removed;
+        }
+        return removed;
+    }
+    // 一次遍历删除所有满足 pred 的元素，返回删除的个数
+    template <typename Predicate>
+    size_t remove_if(Predicate pred){
+        size_t removed = 0;
         for(auto it = begin(); it != end();){
-            if(*it == value){
+            if(pred(*it)){
                 it = erase(it);
+                ++removed;
             }else{
                 ++it;
             }
         }
+        return removed;
+    }
+    // 删除相邻的重复元素（pred(前一个, 当前) 为真即视为重复），只保留每段的第一个
+    template <typename BinaryPredicate = std::equal_to<T>>
+    size_t unique(BinaryPredicate pred = BinaryPredicate()){
+        size_t removed = 0;
+        if(empty()){
+            return removed;
+        }
+        NodeBase * kept = sentinel.next;
+        for(NodeBase * cur = kept->next; cur != &sentinel;){
+            if(pred(value_of(kept), value_of(cur))){
+                cur = erase(iterator(cur)).node_ptr;
+                ++removed;
+            } else {
+                kept = cur;
+                cur = cur->next;
+            }
+        }
+        return removed;
+    }
+
+    // 稳定的归并排序，只改节点指针，不分配内存、不移动元素，迭代器保持有效
+    // 自底向上归并：buckets[i] 存放长度为 2^i 的有序段，额外空间只有这 64 个指针。
+    // cmp 不能抛出异常。
+    template <typename Compare = std::less<T>>
+    void sort(Compare cmp = Compare()){
+        if(node_count < 2){
+            return;
+        }
+        // 先拆成以 nullptr 结尾的单链表，归并时只维护 next，最后统一补上 prev
+        sentinel.prev->next = nullptr;
+        NodeBase * chain = sentinel.next;
+        NodeBase * buckets[64] = {};
+        while(chain != nullptr){
+            NodeBase * run = chain;
+            chain = chain->next;
+            run->next = nullptr;
+            size_t i = 0;
+            for(; buckets[i] != nullptr; ++i){
+                // buckets[i] 中的元素都在 run 之前，放在左边保证稳定
+                run = merge_chains(buckets[i], run, cmp);
+                buckets[i] = nullptr;
+            }
+            buckets[i] = run;
+        }
+        NodeBase * sorted = nullptr;
+        for(NodeBase * bucket : buckets){
+            if(bucket != nullptr){
+                sorted = merge_chains(bucket, sorted, cmp);
+            }
+        }
+        relink(sorted);
+    }
+    // 把有序的 other 归并进有序的 *this，other 变为空；相等元素中 *this 的排在前面
+    // 只改节点指针，不分配内存；与 splice 相同，两边的 Alloc 不相等时抛出 std::invalid_argument，
+    // 检查在修改之前进行，两个链表都不会被改动
+    template <typename Compare = std::less<T>>
+    void merge(List & other, Compare cmp = Compare()){
+        if(&other == this || other.empty()){
+            return;
+        }
+        require_shared_nodes(other);
+        NodeBase * pos = sentinel.next;
+        NodeBase * from = other.sentinel.next;
+        while(from != &other.sentinel){
+            if(pos == &sentinel){
+                take(&sentinel, other, from, &other.sentinel, other.node_count);
+                break;
+            }
+            if(cmp(value_of(from), value_of(pos))){
+                // other 中连续比 pos 小的一段一次接过来
+                NodeBase * last = from->next;
+                size_t n = 1;
+                while(last != &other.sentinel && cmp(value_of(last), value_of(pos))){
+                    last = last->next;
+                    ++n;
+                }
+                take(pos, other, from, last, n);
+                from = last;
+            } else {
+                pos = pos->next;
+            }
+        }
     }
 
     void print() const{
-        Node<T> * current = head->next;
-        while(current != tail){
-            std::cout << current->data << " ";
+        const NodeBase * current = sentinel.next;
+        while(current != &sentinel){
+            std::cout << static_cast<const Node<T> *>(current)->data << " ";
             current = current->next;
         }
         std::cout << std::endl;
     }
 
     iterator begin(){
-        return iterator(head->next);
+        return iterator(sentinel.next);
     }
     iterator end(){
-        return iterator(tail);
+        return iterator(&sentinel);
     }
 
+    // 节点逐个还给 Alloc，使用 NodePool 时留在空闲链表里供之后的 insert 复用
     void clear(){
-        Node<T> * cur = head->next;
-        while(cur != tail){
-            Node<T> * next = cur->next;
-            delete cur;
+        NodeBase * cur = sentinel.next;
+        while(cur != &sentinel){
+            NodeBase * next = cur->next;
+            destroy_node(cur);
             cur = next;
         }
-        head->next = tail;
-        tail->prev = head;
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
+        node_count = 0;
+    }
+
+    // 把 other 的全部元素移到 pos 之前，O(1)
+    void splice(iterator pos, List & other){
+        if(&other == this || other.empty()){
+            return;
+        }
+        require_shared_nodes(other);
+        take(pos.node_ptr, other, other.sentinel.next, &other.sentinel, other.node_count);
+    }
+    // 把 other 中 it 指向的元素移到 pos 之前，other 可以就是 *this，O(1)
+    void splice(iterator pos, List & other, iterator it){
+        NodeBase * next = it.node_ptr->next;
+        if(pos.node_ptr == it.node_ptr || pos.node_ptr == next){
+            return;
+        }
+        require_shared_nodes(other);
+        take(pos.node_ptr, other, it.node_ptr, next, 1);
+    }
+    // 把 other 中 [first, last) 移到 pos 之前，pos 不能在 [first, last) 内
+    // 同一个 List 内移动为 O(1)；跨 List 时需要数一遍区间长度来维护两边的计数，
+    // 调用方已知长度时用下面带 n 的重载，保持 O(1)
+    void splice(iterator pos, List & other, iterator first, iterator last){
+        require_shared_nodes(other);
+        size_t n = 0;
+        if(&other != this){
+            for(const NodeBase * current = first.node_ptr; current != last.node_ptr; current = current->next){
+                ++n;
+            }
+        }
+        splice(pos, other, first, last, n);
+    }
+    // n 必须等于 [first, last) 的元素个数（同一个 List 内移动时忽略）
+    void splice(iterator pos, List & other, iterator first, iterator last, size_t n){
+        if(first == last){
+            return;
+        }
+        require_shared_nodes(other);
+        take(pos.node_ptr, other, first.node_ptr, last.node_ptr, n);
+    }
+
+    Alloc & get_allocator(){
+        return alloc;
     }
 
 private:
-    Node<T> * head;
-    Node<T> * tail;
+    NodeBase sentinel;
+    size_t node_count;
+    Alloc alloc;
+
+    static const T & value_of(const NodeBase * node){
+        return static_cast<const Node<T> *>(node)->data;
+    }
+    // 归并两条以 nullptr 结尾的有序单链表，相等时先取 a 的节点
+    template <typename Compare>
+    static NodeBase * merge_chains(NodeBase * a, NodeBase * b, Compare & cmp){
+        NodeBase head;
+        NodeBase * tail = &head;
+        while(a != nullptr && b != nullptr){
+            if(cmp(value_of(b), value_of(a))){
+                tail->next = b;
+                b = b->next;
+            } else {
+                tail->next = a;
+                a = a->next;
+            }
+            tail = tail->next;
+        }
+        tail->next = a != nullptr ? a : b;
+        return head.next;
+    }
+    // 按 next 顺序把单链表重新接回哨兵两端，并补齐 prev
+    void relink(NodeBase * chain){
+        NodeBase * prev = &sentinel;
+        for(NodeBase * cur = chain; cur != nullptr; cur = cur->next){
+            prev->next = cur;
+            cur->prev = prev;
+            prev = cur;
+        }
+        prev->next = &sentinel;
+        sentinel.prev = prev;
+    }
+    // 把 [first, last) 这一段摘下来接到 pos 之前，只改 6 个指针，不关心节点属于哪个 List
+    static void transfer(NodeBase * pos, NodeBase * first, NodeBase * last){
+        NodeBase * last_in = last->prev;
+        first->prev->next = last;
+        last->prev = first->prev;
+        NodeBase * before = pos->prev;
+        before->next = first;
+        first->prev = before;
+        last_in->next = pos;
+        pos->prev = last_in;
+    }
+
+    // 同一个 List 内移动总是可以的；跨 List 时要求两边的 Alloc 能互相回收节点
+    void require_shared_nodes(const List & other) const{
+        if(&other != this && !(alloc == other.alloc)){
+            throw std::invalid_argument("List: allocators cannot free each other's nodes");
+        }
+    }
+    // 把 other 中 [first, last)（共 n 个元素）接到 pos 之前并维护两边的计数，O(1)
+    void take(NodeBase * pos, List & other, NodeBase * first, NodeBase * last, size_t n){
+        transfer(pos, first, last);
+        if(&other != this){
+            node_count += n;
+            other.node_count -= n;
+        }
+    }
+
+    template <typename... Args>
+    NodeBase * create_node(Args&&... args){
+        void * memory = alloc.allocate();
+        try {
+            return new(memory) Node<T>(std::forward<Args>(args)...);
+        } catch (...) {
+            alloc.deallocate(memory);
+            throw;
+        }
+    }
+    void destroy_node(NodeBase * node){
+        auto * full = static_cast<Node<T> *>(node);
+        full->~Node();
+        alloc.deallocate(full);
+    }
 };
 
 
@@ -0,0 +1,159 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___MPSCQUEUE_H
+#define LEARNC___MPSCQUEUE_H
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// 与 List.h 中 NodeBase/Node 相同的分层：基类只有链接指针，哨兵（stub）只用基类部分
+// 不直接复用 List 的 NodeBase：那里的 prev/next 是普通指针，只在单线程中修改；
+// 这里生产者写 next、消费者同时读 next，next 必须是原子指针，否则就是数据竞争，
+// 而 prev 在单向的 MPSC 链上用不到，留着只会让每个节点多占一个指针。
+struct MpscNodeBase{
+    std::atomic<MpscNodeBase *> next;
+    MpscNodeBase() : next(nullptr){}
+};
+
+template <typename T>
+struct MpscNode : MpscNodeBase{
+    T data;
+    template <typename... Args>
+    explicit MpscNode(Args&&... args) : data(std::forward<Args>(args)...){}
+};
+
+// 无锁多生产者单消费者队列（Vyukov 侵入式 MPSC）
+// push：一次原子 exchange 抢到队尾，再把前一个节点的 next 指向自己，不循环、不等待，
+//       生产者之间只在 head 这一个原子变量上竞争，线程增加时单次 push 的延迟保持稳定。
+// pop/drain：只能由一个消费者线程调用，沿 next 从 tail 向后取。
+// drain 把哨兵 push 到队尾，一次 exchange 就把之前的整条链切下来交给消费者，
+// 之后的遍历不再与生产者竞争 head。
+// 生产者执行完 exchange 但还没写 next 的瞬间，消费者会暂时看不到它及其后的节点，
+// 此时 try_pop 返回空（队列并非真的为空），稍后重试即可。
+template <typename T>
+class MpscQueue{
+public:
+    MpscQueue() : head(&stub), tail(&stub), stub_linked(true){}
+    ~MpscQueue(){
+        // 析构时不应再有生产者
+        drain([](T &&){});
+    }
+    MpscQueue(const MpscQueue & other) = delete;
+    MpscQueue & operator=(const MpscQueue & other) = delete;
+
+    // 任意线程调用
+    void push(const T & value){
+        emplace(value);
+    }
+    void push(T && value){
+        emplace(std::move(value));
+    }
+    template <typename... Args>
+    void emplace(Args&&... args){
+        push_node(new MpscNode<T>(std::forward<Args>(args)...));
+    }
+
+    // 以下只能由消费者线程调用
+    std::optional<T> try_pop(){
+        MpscNode<T> * node = pop_node();
+        if(node == nullptr){
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(node->data));
+        delete node;
+        return value;
+    }
+    // 一次切下当前整条链，按入队顺序调用 fn(T &&)，返回取出的个数
+    // 切下之后若某个生产者已 exchange 但还没链上，会短暂等待它完成；fn 不能抛出异常
+    template <typename Fn>
+    std::size_t drain(Fn && fn){
+        std::size_t count = 0;
+        // 哨兵还在链中时先逐个取，直到越过它，之后才能用哨兵切断整条链
+        while(stub_linked){
+            MpscNode<T> * node = pop_node();
+            if(node == nullptr){
+                return count;
+            }
+            consume(node, fn);
+            ++count;
+        }
+        MpscNodeBase * node = tail;
+        push_node(&stub);
+        stub_linked = true;
+        while(node != &stub){
+            MpscNodeBase * next = node->next.load(std::memory_order_acquire);
+            while(next == nullptr){
+                std::this_thread::yield();
+                next = node->next.load(std::memory_order_acquire);
+            }
+            consume(static_cast<MpscNode<T> *>(node), fn);
+            ++count;
+            node = next;
+        }
+        tail = &stub;
+        return count;
+    }
+    // 消费者视角的“是否为空”，生产者可能正在插入
+    bool empty() const{
+        return tail == &stub && stub.next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    static constexpr std::size_t cache_line = 64;
+    // 生产者写 head，消费者写 tail，分开放在不同的缓存行
+    alignas(cache_line) std::atomic<MpscNodeBase *> head;
+    alignas(cache_line) MpscNodeBase * tail;
+    bool stub_linked; // 哨兵是否在 tail 及其之后的链中，只有消费者读写
+    MpscNodeBase stub;
+
+    template <typename Fn>
+    static void consume(MpscNode<T> * node, Fn & fn){
+        fn(std::move(node->data));
+        delete node;
+    }
+
+    void push_node(MpscNodeBase * node){
+        node->next.store(nullptr, std::memory_order_relaxed);
+        MpscNodeBase * prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+    // 取出最早的节点，返回的节点已不在队列中，由调用方销毁
+    MpscNode<T> * pop_node(){
+        MpscNodeBase * first = tail;
+        MpscNodeBase * next = first->next.load(std::memory_order_acquire);
+        if(first == &stub){
+            if(next == nullptr){
+                return nullptr;
+            }
+            // 跳过哨兵
+            tail = next;
+            stub_linked = false;
+            first = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if(next != nullptr){
+            tail = next;
+            return static_cast<MpscNode<T> *>(first);
+        }
+        if(first != head.load(std::memory_order_acquire)){
+            // 有生产者已经 exchange 但还没链上
+            return nullptr;
+        }
+        // first 是最后一个节点：把哨兵放回队尾，first 才有后继，才能安全取走
+        push_node(&stub);
+        stub_linked = true;
+        next = first->next.load(std::memory_order_acquire);
+        if(next != nullptr){
+            tail = next;
+            return static_cast<MpscNode<T> *>(first);
+        }
+        return nullptr;
+    }
+};
+
+
+#endif //LEARNC___MPSCQUEUE_H
@@ -0,0 +1,302 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___UNROLLEDLIST_H
+#define LEARNC___UNROLLEDLIST_H
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <utility>
+
+// 展开链表：接口与 List 一致（insert/erase/push_front/push_back/双向迭代器），
+// 但每个块存放一小段连续的元素，而不是一个节点一个元素。
+// 顺序遍历时一次缓存未命中能读到一整块元素，指针追逐的次数约为 List 的 1/capacity。
+// 每块按 BlockBytes 字节（默认 4 条缓存行）放尽可能多的元素，至少 4 个。
+// 块内元素始终紧凑存放在 [0, count)，在满块中间插入时对半分裂，在满块两端插入时另起一块，
+// 删除后过空的块与后继合并。
+//
+// 迭代器失效规则：
+// 1. insert/emplace/push_*：指向被插入的块的迭代器全部失效（块分裂时包括新块），其他块不受影响
+// 2. erase/pop_*：指向被删除元素所在块及其后继块的迭代器全部失效，其他块不受影响
+// 3. end() 永远有效；clear() 使所有迭代器失效
+template <typename T, std::size_t BlockBytes = 256>
+class UnrolledList {
+private:
+    struct BlockBase{
+        BlockBase * prev;
+        BlockBase * next;
+        std::size_t count;
+        BlockBase() : prev(nullptr), next(nullptr), count(0){}
+    };
+    static constexpr std::size_t max_of(std::size_t a, std::size_t b){
+        return a > b ? a : b;
+    }
+    static constexpr std::size_t capacity = max_of(4, (BlockBytes - sizeof(BlockBase)) / sizeof(T));
+    struct Block : BlockBase{
+        alignas(T) unsigned char storage[capacity * sizeof(T)];
+        T * slots(){
+            return std::launder(reinterpret_cast<T *>(storage));
+        }
+    };
+    static T * slots_of(BlockBase * block){
+        return static_cast<Block *>(block)->slots();
+    }
+
+public:
+    class Iterator{
+    public:
+        using self_type = Iterator;
+        using value_type = T;
+        using reference = T&;
+        using pointer = T*;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator(BlockBase * block = nullptr, std::size_t index = 0) : block(block), index(index){}
+        reference operator* () const{return slots_of(block)[index];}
+        pointer operator-> () const{return slots_of(block) + index;}
+        self_type & operator++(){
+            if(++index == block->count){
+                block = block->next;
+                index = 0;
+            }
+            return *this;
+        }
+        self_type operator++(int){
+            self_type temp = *this;
+            ++(*this);
+            return temp;
+        }
+        self_type & operator--(){
+            if(index == 0){
+                block = block->prev;
+                index = block->count;
+            }
+            --index;
+            return *this;
+        }
+        self_type operator--(int){
+            self_type temp = *this;
+            --(*this);
+            return temp;
+        }
+        bool operator==(const self_type & other) const{
+            return block == other.block && index == other.index;
+        }
+        bool operator!=(const self_type & other) const{
+            return !(*this == other);
+        }
+    private:
+        BlockBase * block;
+        std::size_t index;
+        friend class UnrolledList;
+    };
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    UnrolledList() : node_count(0){
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
+    }
+    ~UnrolledList(){
+        clear();
+    }
+    UnrolledList(const UnrolledList & other) = delete;
+    UnrolledList & operator=(const UnrolledList & other) = delete;
+
+    // 每块最多存放的元素个数
+    static constexpr std::size_t block_capacity(){
+        return capacity;
+    }
+
+    iterator insert(iterator pos, const T & value){
+        return emplace(pos, value);
+    }
+    iterator insert(iterator pos, T && value){
+        return emplace(pos, std::move(value));
+    }
+    template <typename... Args>
+    iterator emplace(iterator pos, Args&&... args){
+        // 先构造好元素，构造抛异常时链表保持不变
+        T value(std::forward<Args>(args)...);
+        BlockBase * block = pos.block;
+        std::size_t index = pos.index;
+        if(block == &sentinel){
+            // 插在末尾：放进最后一块的尾部
+            block = sentinel.prev;
+            index = block->count;
+            if(block == &sentinel){
+                block = link_new_block(&sentinel);
+                index = 0;
+            }
+        }
+        if(block->count == capacity && (index == 0 || index == capacity)){
+            // 满块的两端插入（push_front/push_back 的常见情况）直接另起一块，前后的块都保持满载
+            block = link_new_block(index == 0 ? block : block->next);
+            index = 0;
+        } else if(block->count == capacity){
+            // 满块对半分裂，后一半搬到紧跟其后的新块
+            BlockBase * right = link_new_block(block->next);
+            std::size_t half = capacity / 2;
+            T * from = slots_of(block);
+            T * to = slots_of(right);
+            for(std::size_t i = half; i < capacity; ++i){
+                new(to + (i - half)) T(std::move(from[i]));
+                from[i].~T();
+            }
+            right->count = capacity - half;
+            block->count = half;
+            if(index > half){
+                block = right;
+                index -= half;
+            }
+        }
+        T * slots = slots_of(block);
+        if(index == block->count){
+            new(slots + index) T(std::move(value));
+        } else {
+            new(slots + block->count) T(std::move(slots[block->count - 1]));
+            std::move_backward(slots + index, slots + block->count - 1, slots + block->count);
+            slots[index] = std::move(value);
+        }
+        ++block->count;
+        ++node_count;
+        return iterator(block, index);
+    }
+    iterator erase(iterator pos){
+        BlockBase * block = pos.block;
+        if(block == &sentinel){
+            return end();
+        }
+        std::size_t index = pos.index;
+        T * slots = slots_of(block);
+        std::move(slots + index + 1, slots + block->count, slots + index);
+        slots[block->count - 1].~T();
+        --block->count;
+        --node_count;
+        if(block->count == 0){
+            BlockBase * next = block->next;
+            unlink_block(block);
+            return iterator(next, 0);
+        }
+        // 过空的块把后继并进来，避免大量删除后遍历退化成逐元素跳块
+        BlockBase * next = block->next;
+        if(block->count < capacity / 4 && next != &sentinel && block->count + next->count <= capacity){
+            T * next_slots = slots_of(next);
+            for(std::size_t i = 0; i < next->count; ++i){
+                new(slots + block->count + i) T(std::move(next_slots[i]));
+                next_slots[i].~T();
+            }
+            block->count += next->count;
+            next->count = 0;
+            unlink_block(next);
+        }
+        if(index == block->count){
+            return iterator(block->next, 0);
+        }
+        return iterator(block, index);
+    }
+    void push_front(const T & value){
+        insert(begin(), value);
+    }
+    void push_front(T && value){
+        insert(begin(), std::move(value));
+    }
+    void push_back(const T & value){
+        insert(end(), value);
+    }
+    void push_back(T && value){
+        insert(end(), std::move(value));
+    }
+    void pop_front(){
+        if(!empty()){
+            erase(begin());
+        }
+    }
+    void pop_back(){
+        if(!empty()){
+            iterator temp = end();
+            --temp;
+            erase(temp);
+        }
+    }
+
+    T & front(){
+        return slots_of(sentinel.next)[0];
+    }
+    T & back(){
+        return slots_of(sentinel.prev)[sentinel.prev->count - 1];
+    }
+    bool empty() const{
+        return node_count == 0;
+    }
+    size_t size() const{
+        return node_count;
+    }
+
+    void remove(const T & value){
+        for(auto it = begin(); it != end();){
+            if(*it == value){
+                it = erase(it);
+            }else{
+                ++it;
+            }
+        }
+    }
+
+    void print(){
+        for(auto it = begin(); it != end(); ++it){
+            std::cout << *it << " ";
+        }
+        std::cout << std::endl;
+    }
+
+    iterator begin(){
+        return iterator(sentinel.next, 0);
+    }
+    iterator end(){
+        return iterator(&sentinel, 0);
+    }
+
+    void clear(){
+        BlockBase * cur = sentinel.next;
+        while(cur != &sentinel){
+            BlockBase * next = cur->next;
+            T * slots = slots_of(cur);
+            for(std::size_t i = 0; i < cur->count; ++i){
+                slots[i].~T();
+            }
+            delete static_cast<Block *>(cur);
+            cur = next;
+        }
+        sentinel.next = &sentinel;
+        sentinel.prev = &sentinel;
+        node_count = 0;
+    }
+
+private:
+    BlockBase sentinel;
+    size_t node_count;
+
+    // 在 pos 之前接入一个空块
+    static BlockBase * link_new_block(BlockBase * pos){
+        BlockBase * block = new Block;
+        block->next = pos;
+        block->prev = pos->prev;
+        pos->prev->next = block;
+        pos->prev = block;
+        return block;
+    }
+    // 摘下并释放一个已经没有元素的块
+    static void unlink_block(BlockBase * block){
+        block->prev->next = block->next;
+        block->next->prev = block->prev;
+        delete static_cast<Block *>(block);
+    }
+};
+
+
+#endif //LEARNC___UNROLLEDLIST_H
@@ -0,0 +1,146 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// 1. LRU 式的节点周转：链表长度保持不变，每一步从尾部删除一个节点、在头部插入一个新节点
+// 2. 顺序遍历：List、UnrolledList、std::list 求和，分别在刚建好和删除一半再补齐之后测量
+// 3. 排序：List::sort 与 std::list::sort，都是只改指针的归并排序
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <list>
+#include <random>
+#include <string>
+#include "List.h"
+#include "UnrolledList.h"
+#include "IntrusiveList.h"
+#include <vector>
+
+template <typename Fn>
+static double measure_ms(Fn && fn){
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+template <typename ListType>
+static double churn_ms(long long length, long long steps, long long & checksum){
+    ListType list;
+    for(long long i = 0; i < length; ++i){
+        list.push_back(i);
+    }
+    double ms = measure_ms([&](){
+        for(long long i = 0; i < steps; ++i){
+            checksum += list.back();
+            list.pop_back();
+            list.push_front(i);
+        }
+    });
+    checksum += list.front();
+    return ms;
+}
+
+struct PooledEntry : ListHook<>{
+    long long value;
+};
+
+// 侵入式链表的周转：元素预先放在数组里，尾部摘下的对象直接挂回头部，整个过程不分配内存
+static double intrusive_churn_ms(long long length, long long steps, long long & checksum){
+    std::vector<PooledEntry> entries(length);
+    IntrusiveList<PooledEntry> list;
+    for(auto & entry : entries){
+        list.push_back(entry);
+    }
+    double ms = measure_ms([&](){
+        for(long long i = 0; i < steps; ++i){
+            PooledEntry & entry = list.back();
+            checksum += entry.value;
+            list.pop_back();
+            entry.value = i;
+            list.push_front(entry);
+        }
+    });
+    checksum += list.front().value;
+    return ms;
+}
+
+// 遍历 rounds 次求和，返回每个元素的平均耗时（ns）
+template <typename ListType>
+static double traverse_ns(ListType & list, int rounds, long long & checksum){
+    double ms = measure_ms([&](){
+        for(int round = 0; round < rounds; ++round){
+            for(auto it = list.begin(); it != list.end(); ++it){
+                checksum += *it;
+            }
+        }
+    });
+    return ms * 1e6 / (static_cast<double>(list.size()) * rounds);
+}
+
+template <typename ListType>
+static void report_traverse(const std::string & name, long long n, int rounds, long long & checksum){
+    ListType list;
+    for(long long i = 0; i < n; ++i){
+        list.push_back(i);
+    }
+    double fresh = traverse_ns(list, rounds, checksum);
+    // 隔一个删一个再补齐：回收的节点打乱了内存中的顺序，更接近长期运行后的状态
+    for(auto it = list.begin(); it != list.end();){
+        it = list.erase(it);
+        if(it != list.end()){
+            ++it;
+        }
+    }
+    while(static_cast<long long>(list.size()) < n){
+        list.push_back(static_cast<long long>(list.size()));
+    }
+    double aged = traverse_ns(list, rounds, checksum);
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << fresh << std::setw(12) << aged << std::endl;
+}
+
+template <typename ListType>
+static double sort_ms(long long n, long long & checksum){
+    ListType list;
+    std::mt19937_64 rng(11);
+    for(long long i = 0; i < n; ++i){
+        list.push_back(static_cast<long long>(rng() % n));
+    }
+    double ms = measure_ms([&](){ list.sort(); });
+    checksum += list.front() + list.back();
+    return ms;
+}
+
+int main(int argc, char * argv[]){
+    long long steps = argc > 1 ? std::atoll(argv[1]) : 10000000;
+    long long length = argc > 2 ? std::atoll(argv[2]) : 100000;
+    long long checksum = 0;
+    std::cout << "churn, length = " << length << ", " << steps << " pop_back + push_front (ms)" << std::endl;
+    std::cout << std::left << std::setw(24) << "List + NodePool" << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << churn_ms<List<long long, NodePool<Node<long long>>>>(length, steps, checksum) << std::endl;
+    std::cout << std::left << std::setw(24) << "List + new/delete" << std::right
+              << std::setw(12) << churn_ms<List<long long>>(length, steps, checksum) << std::endl;
+    std::cout << std::left << std::setw(24) << "std::list" << std::right
+              << std::setw(12) << churn_ms<std::list<long long>>(length, steps, checksum) << std::endl;
+    std::cout << std::left << std::setw(24) << "IntrusiveList" << std::right
+              << std::setw(12) << intrusive_churn_ms(length, steps, checksum) << std::endl;
+
+    long long n = argc > 3 ? std::atoll(argv[3]) : 4000000;
+    int rounds = 5;
+    std::cout << "traverse " << n << " elements (ns per element)" << std::endl;
+    std::cout << std::left << std::setw(24) << "list" << std::right
+              << std::setw(12) << "fresh" << std::setw(12) << "aged" << std::endl;
+    report_traverse<List<long long, NodePool<Node<long long>>>>("List + NodePool", n, rounds, checksum);
+    report_traverse<List<long long>>("List + new/delete", n, rounds, checksum);
+    report_traverse<std::list<long long>>("std::list", n, rounds, checksum);
+    report_traverse<UnrolledList<long long>>("UnrolledList", n, rounds, checksum);
+
+    std::cout << "sort " << n << " random elements (ms)" << std::endl;
+    std::cout << std::left << std::setw(24) << "List::sort" << std::right
+              << std::setw(12) << sort_ms<List<long long>>(n, checksum) << std::endl;
+    std::cout << std::left << std::setw(24) << "std::list::sort" << std::right
+              << std::setw(12) << sort_ms<std::list<long long>>(n, checksum) << std::endl;
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
@@ -0,0 +1,59 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// 多线程 LRU：每个线程 90% get、10% put，键集中在一个热点区间
+// 对比 1 个分片（相当于整个缓存一把锁）和 16 个分片
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "LRUCache.h"
+
+static double run(std::size_t shards, int threads, long long ops_per_thread, long long key_range, double & hit_ratio){
+    ShardedLRUCache<long long, long long> cache(static_cast<std::size_t>(key_range / 4), shards);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t){
+        workers.emplace_back([&, t](){
+            std::mt19937_64 rng(t + 1);
+            for(long long i = 0; i < ops_per_thread; ++i){
+                // 两个随机数取较小值，小键被访问得更频繁
+                long long key = static_cast<long long>(std::min(rng() % key_range, rng() % key_range));
+                if(i % 10 == 0){
+                    cache.put(key, i);
+                } else if(!cache.get(key)){
+                    cache.put(key, i);
+                }
+            }
+        });
+    }
+    for(auto & worker : workers){
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    hit_ratio = static_cast<double>(cache.hits()) / static_cast<double>(cache.hits() + cache.misses());
+    return static_cast<double>(threads) * static_cast<double>(ops_per_thread) / seconds / 1e6;
+}
+
+int main(int argc, char * argv[]){
+    long long ops = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    long long key_range = argc > 2 ? std::atoll(argv[2]) : 100000;
+    unsigned max_threads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3]))
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "ops per thread = " << ops << ", key range = " << key_range
+              << ", capacity = " << key_range / 4 << " (Mops/s)" << std::endl;
+    std::cout << "threads    1 shard   16 shards   hit ratio" << std::endl;
+    for(unsigned threads = 1; threads <= max_threads; threads *= 2){
+        double hit_ratio = 0;
+        double single = run(1, static_cast<int>(threads), ops, key_range, hit_ratio);
+        double sharded = run(16, static_cast<int>(threads), ops, key_range, hit_ratio);
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(11) << single << std::setw(12) << sharded << std::setw(12) << hit_ratio << std::endl;
+    }
+    return 0;
+}
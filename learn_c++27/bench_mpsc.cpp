@@ -0,0 +1,109 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// 多生产者单消费者：日志式写入，生产者只管 push，一个消费者批量取走
+// 对比 MpscQueue 与“互斥锁 + List”（消费者在锁内 splice 走整条链），
+// 每 64 次 push 计一次时，报告单次 push 的平均延迟和 p99
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "List.h"
+#include "MpscQueue.h"
+
+struct LockedList{
+    std::mutex mtx;
+    List<long long, NewDeleteAllocator<Node<long long>>> items;
+    void push(long long value){
+        std::lock_guard<std::mutex> lock(mtx);
+        items.push_back(value);
+    }
+    template <typename Fn>
+    std::size_t drain(Fn && fn){
+        List<long long, NewDeleteAllocator<Node<long long>>> batch;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            batch.splice(batch.end(), items);
+        }
+        for(auto it = batch.begin(); it != batch.end(); ++it){
+            fn(std::move(*it));
+        }
+        return batch.size();
+    }
+};
+
+struct Result{
+    double mean_ns;
+    double p99_ns;
+};
+
+template <typename Queue>
+static Result run(int producers, long long pushes_per_thread, long long & checksum){
+    constexpr long long batch = 64;
+    Queue queue;
+    std::atomic<int> running(producers);
+    std::vector<std::vector<double>> samples(producers);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < producers; ++t){
+        threads.emplace_back([&, t](){
+            auto & local = samples[t];
+            local.reserve(pushes_per_thread / batch + 1);
+            for(long long i = 0; i < pushes_per_thread; i += batch){
+                auto start = std::chrono::steady_clock::now();
+                for(long long j = i; j < i + batch; ++j){
+                    queue.push(j);
+                }
+                auto end = std::chrono::steady_clock::now();
+                local.push_back(std::chrono::duration<double, std::nano>(end - start).count() / batch);
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    }
+    long long consumed = 0;
+    auto sum = [&](long long && value){ checksum += value; ++consumed; };
+    while(running.load(std::memory_order_acquire) > 0){
+        if(queue.drain(sum) == 0){
+            std::this_thread::yield();
+        }
+    }
+    for(auto & thread : threads){
+        thread.join();
+    }
+    while(consumed < producers * (pushes_per_thread / batch * batch)){
+        queue.drain(sum);
+    }
+    std::vector<double> all;
+    for(auto & local : samples){
+        all.insert(all.end(), local.begin(), local.end());
+    }
+    std::sort(all.begin(), all.end());
+    double total = 0;
+    for(double sample : all){
+        total += sample;
+    }
+    return Result{total / static_cast<double>(all.size()), all[all.size() * 99 / 100]};
+}
+
+int main(int argc, char * argv[]){
+    long long pushes = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    unsigned max_threads = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2]))
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    long long checksum = 0;
+    std::cout << "pushes per producer = " << pushes << " (ns per push)" << std::endl;
+    std::cout << "producers   mutex+List mean     p99   MpscQueue mean     p99" << std::endl;
+    for(unsigned producers = 1; producers <= max_threads; producers *= 2){
+        Result locked = run<LockedList>(static_cast<int>(producers), pushes, checksum);
+        Result lock_free = run<MpscQueue<long long>>(static_cast<int>(producers), pushes, checksum);
+        std::cout << std::setw(9) << producers << std::fixed << std::setprecision(1)
+                  << std::setw(18) << locked.mean_ns << std::setw(8) << locked.p99_ns
+                  << std::setw(17) << lock_free.mean_ns << std::setw(8) << lock_free.p99_ns << std::endl;
+    }
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
@@ -4,6 +4,30 @@
 
 #include <iostream>
 #include "List.h"
+#include "UnrolledList.h"
+#include "IntrusiveList.h"
+#include "LRUCache.h"
+#include "MpscQueue.h"
+#include <thread>
+#include <string>
+#include <vector>
+
+// 侵入式链表的元素：前后指针就在对象里
+struct Task : ListHook<>{
+    int id;
+    explicit Task(int id) : id(id){}
+};
+
+std::ostream & operator<<(std::ostream & os, const Task & task){
+    return os << "task" << task.id;
+}
+
+// 按字节计容量：键和值的字符数之和
+struct StringBytes{
+    std::size_t operator()(const std::string & key, const std::string & value) const{
+        return key.size() + value.size();
+    }
+};
 
 int main(){
     List<int> numbers;
@@ -41,5 +65,112 @@ int main(){
     }
     std::cout << std::endl;
 
+    // splice：同一个池里的两个链表之间移动节点，只改指针，size() 始终为 O(1)
+    NodePool<Node<int>> pool;
+    using PooledList = List<int, NodePoolRef<NodePool<Node<int>>>>;
+    PooledList hot{NodePoolRef<NodePool<Node<int>>>(pool)};
+    PooledList cold{NodePoolRef<NodePool<Node<int>>>(pool)};
+    for(int i = 1; i <= 6; ++i){
+        hot.push_back(i);
+    }
+    auto first = hot.begin();
+    ++first;
+    auto last = first;
+    ++last;
+    ++last;
+    cold.splice(cold.end(), hot, first, last, 2);
+    hot.splice(hot.begin(), hot, --hot.end());
+    hot.print();
+    cold.print();
+    std::cout << "hot size: " << hot.size() << ", cold size: " << cold.size() << std::endl;
+    // 默认的 NewDeleteAllocator 可以互相回收节点，跨链表 splice 只改指针，源链表析构后不受影响
+    List<int> target;
+    {
+        List<int> source;
+        for(int i = 1; i <= 3; ++i){
+            source.push_back(i * 10);
+        }
+        target.splice(target.end(), source);
+    }
+    target.print();
+    // 各自独占 NodePool 的两个链表不能互相回收节点，splice 会被拒绝，两边都保持原样
+    List<int, NodePool<Node<int>>> own_a;
+    List<int, NodePool<Node<int>>> own_b;
+    own_a.push_back(1);
+    try {
+        own_b.splice(own_b.end(), own_a);
+    } catch (const std::invalid_argument & e) {
+        std::cout << e.what() << ", own_a size: " << own_a.size() << std::endl;
+    }
+
+    // 排序、归并、去重、按条件删除：只改节点指针，不分配内存
+    List<int> odd;
+    List<int> even;
+    for(int i : {9, 3, 7, 3, 1, 5}){
+        odd.push_back(i);
+    }
+    for(int i : {8, 2, 2, 6, 4}){
+        even.push_back(i);
+    }
+    odd.sort();
+    even.sort();
+    odd.merge(even);
+    odd.unique();
+    odd.remove_if([](int value){ return value > 7; });
+    odd.print();
+
+    // 展开链表：每块存放多个元素，接口与 List 相同
+    UnrolledList<int> unrolled;
+    for(int i = 0; i < 100; ++i){
+        unrolled.push_back(i);
+    }
+    unrolled.remove(50);
+    unrolled.insert(unrolled.begin(), -1);
+    std::cout << "unrolled size: " << unrolled.size() << ", front: " << unrolled.front()
+              << ", back: " << unrolled.back() << ", block capacity: " << UnrolledList<int>::block_capacity() << std::endl;
+
+    // 侵入式链表：元素来自外部的数组，挂入和摘下都不分配内存，元素可以自己摘下
+    std::vector<Task> tasks;
+    for(int i = 0; i < 5; ++i){
+        tasks.emplace_back(i);
+    }
+    IntrusiveList<Task> ready;
+    for(auto & task : tasks){
+        ready.push_back(task);
+    }
+    tasks[2].unlink();
+    ready.erase(IntrusiveList<Task>::iterator_to(tasks[4]));
+    ready.push_front(tasks[4]);
+    ready.print();
+    std::cout << "ready size: " << ready.size() << ", task2 linked: " << tasks[2].is_linked() << std::endl;
+
+    // LRU 缓存：容量按字节计，淘汰时回调
+    LRUCache<std::string, std::string, StringBytes> cache(16);
+    cache.set_eviction_callback([](const std::string & key, std::string & value){
+        std::cout << "evict " << key << "=" << value << std::endl;
+    });
+    cache.put("a", "apple");
+    cache.put("b", "banana");
+    cache.get("a");
+    cache.put("c", "cherry");
+    std::cout << "cache size: " << cache.size() << ", usage: " << cache.usage() << ", hits: " << cache.hits()
+              << ", misses: " << cache.misses() << ", has b: " << cache.contains("b") << std::endl;
+
+    // 多生产者单消费者队列：多个线程写日志，一个线程批量取走
+    MpscQueue<std::string> logs;
+    std::vector<std::thread> loggers;
+    for(int t = 0; t < 3; ++t){
+        loggers.emplace_back([&logs, t](){
+            for(int i = 0; i < 2; ++i){
+                logs.push("thread" + std::to_string(t) + " record" + std::to_string(i));
+            }
+        });
+    }
+    for(auto & logger : loggers){
+        logger.join();
+    }
+    std::size_t drained = logs.drain([](std::string && record){ std::cout << record << " "; });
+    std::cout << std::endl << "drained " << drained << " records" << std::endl;
+
     return 0;
 }
\ No newline at end of file
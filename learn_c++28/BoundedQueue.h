@@ -0,0 +1,143 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___BOUNDEDQUEUE_H
+#define LEARNC___BOUNDEDQUEUE_H
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include "Deque.h"
+
+// 队列满时生产者的处理策略
+enum class OverflowPolicy {
+    Block,      // 阻塞等待空位
+    DropOldest, // 丢弃队首最旧的元素，为新元素腾位置
+    Reject      // 直接拒绝新元素
+};
+
+// 多生产者/多消费者有界阻塞队列，底层存储为 Deque
+// 关闭协议：close() 之后不再接受新元素，消费者仍可取完剩余元素，取空后 pop 返回 false
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t capacity, OverflowPolicy policy = OverflowPolicy::Block) :
+        items(capacity == 0 ? 1 : capacity), capacity_(capacity == 0 ? 1 : capacity),
+        policy_(policy), closed_(false), dropped_(0){}
+    BoundedQueue(const BoundedQueue & other) = delete;
+    BoundedQueue & operator = (const BoundedQueue & other) = delete;
+
+    // 按策略写入，队列已关闭或被拒绝时返回 false
+    bool push(const T & value){
+        T copy(value);
+        return push(std::move(copy));
+    }
+    bool push(T && value){
+        std::unique_lock<std::mutex> lock(mtx);
+        if(policy_ == OverflowPolicy::Block){
+            not_full.wait(lock, [this](){ return closed_ || items.size() < capacity_; });
+        }
+        return enqueue(lock, std::move(value));
+    }
+    // 带超时的写入，仅 Block 策略下会真正等待
+    template <typename Rep, typename Period>
+    bool try_push(T && value, const std::chrono::duration<Rep, Period> & timeout){
+        std::unique_lock<std::mutex> lock(mtx);
+        if(policy_ == OverflowPolicy::Block){
+            if(!not_full.wait_for(lock, timeout, [this](){ return closed_ || items.size() < capacity_; })){
+                return false;
+            }
+        }
+        return enqueue(lock, std::move(value));
+    }
+    template <typename Rep, typename Period>
+    bool try_push(const T & value, const std::chrono::duration<Rep, Period> & timeout){
+        T copy(value);
+        return try_push(std::move(copy), timeout);
+    }
+
+    // 阻塞读取，队列关闭且已取空时返回 false
+    bool pop(T & out){
+        std::unique_lock<std::mutex> lock(mtx);
+        not_empty.wait(lock, [this](){ return closed_ || !items.empty(); });
+        return dequeue(lock, out);
+    }
+    template <typename Rep, typename Period>
+    bool try_pop(T & out, const std::chrono::duration<Rep, Period> & timeout){
+        std::unique_lock<std::mutex> lock(mtx);
+        if(!not_empty.wait_for(lock, timeout, [this](){ return closed_ || !items.empty(); })){
+            return false;
+        }
+        return dequeue(lock, out);
+    }
+
+    // 关闭队列并唤醒所有等待者
+    void close(){
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            closed_ = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+    bool closed() const{
+        std::lock_guard<std::mutex> lock(mtx);
+        return closed_;
+    }
+    [[nodiscard]] std::size_t size() const{
+        std::lock_guard<std::mutex> lock(mtx);
+        return items.size();
+    }
+    [[nodiscard]] std::size_t capacity() const{
+        return capacity_;
+    }
+    // DropOldest 策略下累计丢弃的元素个数
+    [[nodiscard]] std::size_t dropped() const{
+        std::lock_guard<std::mutex> lock(mtx);
+        return dropped_;
+    }
+
+private:
+    mutable std::mutex mtx;
+    std::condition_variable not_full;
+    std::condition_variable not_empty;
+    Deque<T> items;
+    std::size_t capacity_;
+    OverflowPolicy policy_;
+    bool closed_;
+    std::size_t dropped_;
+
+    // 调用时已持有锁
+    bool enqueue(std::unique_lock<std::mutex> & lock, T && value){
+        if(closed_){
+            return false;
+        }
+        if(items.size() >= capacity_){
+            if(policy_ == OverflowPolicy::Reject){
+                return false;
+            }
+            // DropOldest
+            items.pop_front();
+            ++dropped_;
+        }
+        items.push_back(std::move(value));
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+    bool dequeue(std::unique_lock<std::mutex> & lock, T & out){
+        if(items.empty()){
+            return false; // 已关闭且取空
+        }
+        out = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return true;
+    }
+};
+
+
+#endif //LEARNC___BOUNDEDQUEUE_H
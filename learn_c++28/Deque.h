@@ -5,6 +5,13 @@
 #ifndef LEARNC___DEQUE_H
 #define LEARNC___DEQUE_H
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 template <typename T>
 class Deque {
@@ -14,6 +21,17 @@ private:
     std::size_t count;
     std::size_t front_idx;
     std::size_t back_idx;
+    // 平凡可拷贝类型直接 memcpy，其余类型逐个赋值
+    static void copy_elements(T * dst, const T * src, size_t n){
+        if(n == 0){
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>){
+            std::memcpy(dst, src, n * sizeof(T));
+        } else {
+            std::copy(src, src + n, dst);
+        }
+    }
 public:
     Deque(size_t initial_capacity = 10) : capacity(initial_capacity), count(0), front_idx(0), back_idx(0){
         buffer = new T[capacity]();
@@ -30,7 +48,7 @@ public:
     void resize(size_t new_capacity){
         T * new_buffer = new T[new_capacity]();
         for(size_t i = 0; i < count; ++i){
-            new_buffer[i] = buffer[(front_idx + i) % capacity];
+            new_buffer[i] = std::move(buffer[(front_idx + i) % capacity]);
         }
         front_idx = 0;
         back_idx = count;
@@ -46,6 +64,14 @@ public:
         buffer[front_idx] = value;
         ++count;
     }
+    void push_front(T&& value){
+        if(count == capacity){
+            resize(capacity * 2);
+        }
+        front_idx = front_idx == 0 ? capacity - 1 : front_idx - 1;
+        buffer[front_idx] = std::move(value);
+        ++count;
+    }
     void push_back(const T& value){
         if(count == capacity){
             resize(capacity * 2);
@@ -54,6 +80,14 @@ public:
         back_idx = (back_idx + 1) % capacity;
         ++count;
     }
+    void push_back(T&& value){
+        if(count == capacity){
+            resize(capacity * 2);
+        }
+        buffer[back_idx] = std::move(value);
+        back_idx = (back_idx + 1) % capacity;
+        ++count;
+    }
     void pop_front(){
         if(empty()){
             throw std::out_of_range("Deque is empty");
@@ -95,17 +129,98 @@ public:
         }
         return buffer[front_idx];
     }
-    class Iterator{
+    T& operator [] (size_t index){
+        return buffer[(front_idx + index) % capacity];
+    }
+    const T& operator [] (size_t index) const{
+        return buffer[(front_idx + index) % capacity];
+    }
+    T& at(size_t index){
+        if(index >= count){
+            throw std::out_of_range("Deque index out of range");
+        }
+        return (*this)[index];
+    }
+    const T& at(size_t index) const{
+        if(index >= count){
+            throw std::out_of_range("Deque index out of range");
+        }
+        return (*this)[index];
+    }
+
+    // 环形缓冲区最多被分成两段连续内存：[front_idx, 缓冲区末尾) 和 [0, back_idx)
+    // 没有回绕时第二段为空
+    std::pair<std::span<T>, std::span<T>> segments(){
+        size_t first_len = std::min(count, capacity - front_idx);
+        return {std::span<T>(buffer + front_idx, first_len), std::span<T>(buffer, count - first_len)};
+    }
+    std::pair<std::span<const T>, std::span<const T>> segments() const{
+        size_t first_len = std::min(count, capacity - front_idx);
+        return {std::span<const T>(buffer + front_idx, first_len), std::span<const T>(buffer, count - first_len)};
+    }
+    // 从队首开始拷贝最多 n 个元素到 dst（不出队），返回实际拷贝个数
+    size_t copy_out(T * dst, size_t n) const{
+        if(n > count){
+            n = count;
+        }
+        auto [first, second] = segments();
+        size_t first_len = std::min(n, first.size());
+        copy_elements(dst, first.data(), first_len);
+        copy_elements(dst + first_len, second.data(), n - first_len);
+        return n;
+    }
+    // 把 src 中的 n 个元素追加到队尾，容量不足时只扩容一次
+    void copy_in(const T * src, size_t n){
+        // n 为 0 时不扩容，容量可能仍为 0，不能进行下面的取模
+        if(n == 0){
+            return;
+        }
+        if(count + n > capacity){
+            size_t new_capacity = capacity == 0 ? 1 : capacity * 2;
+            while(new_capacity < count + n){
+                new_capacity *= 2;
+            }
+            resize(new_capacity);
+        }
+        size_t first_len = std::min(n, capacity - back_idx);
+        copy_elements(buffer + back_idx, src, first_len);
+        copy_elements(buffer, src + first_len, n - first_len);
+        back_idx = (back_idx + n) % capacity;
+        count += n;
+    }
+    // 一次丢弃队首 n 个元素，常与 copy_out/segments 配合使用
+    void pop_front_n(size_t n){
+        if(n > count){
+            throw std::out_of_range("Deque has fewer elements than requested");
+        }
+        if(n == 0){
+            return;
+        }
+        front_idx = (front_idx + n) % capacity;
+        count -= n;
+    }
+
+    // 迭代器只保存逻辑偏移量 pos，因此可以支持随机访问
+    // IsConst 为 true 时是 const 迭代器
+    template <bool IsConst>
+    class IteratorBase{
     private:
-        Deque<T> * deque_ptr;
+        using deque_type = std::conditional_t<IsConst, const Deque<T>, Deque<T>>;
+        deque_type * deque_ptr;
         size_t pos; // 迭代器偏移量
+        friend class IteratorBase<!IsConst>;
     public:
-        using iterator_category = std::bidirectional_iterator_tag; // 迭代器类型
+        using iterator_category = std::random_access_iterator_tag; // 迭代器类型
         using value_type = T; // 迭代器所迭代的值的类型
         using difference_type = std::ptrdiff_t; // 迭代器所迭代的元素之间的距离
-        using pointer = T*; // 迭代器所迭代元素的指针
-        using reference = T&; // 迭代器所迭代元素的引用
-        Iterator(Deque<T> * deque, size_t position) : deque_ptr(deque), pos(position){}
+        using pointer = std::conditional_t<IsConst, const T*, T*>; // 迭代器所迭代元素的指针
+        using reference = std::conditional_t<IsConst, const T&, T&>; // 迭代器所迭代元素的引用
+        IteratorBase() : deque_ptr(nullptr), pos(0){}
+        IteratorBase(deque_type * deque, size_t position) : deque_ptr(deque), pos(position){}
+        // 普通迭代器可以隐式转换为 const 迭代器
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        IteratorBase(const IteratorBase<OtherConst> & other) : deque_ptr(other.deque_ptr), pos(other.pos){}
+
         reference operator * () const{
             size_t real_idx = (deque_ptr->front_idx + pos) % (deque_ptr->capacity);
             return deque_ptr->buffer[real_idx];
@@ -114,32 +229,71 @@ public:
             size_t real_idx = (deque_ptr->front_idx + pos) % (deque_ptr->capacity);
             return &(deque_ptr->buffer[real_idx]);
         }
-        Iterator& operator ++ (){
+        reference operator [] (difference_type n) const{
+            return *(*this + n);
+        }
+        IteratorBase& operator ++ (){
             ++pos;
             return *this;
         }
-        Iterator operator ++ (int){
+        IteratorBase operator ++ (int){
             // 返回当前迭代器，再让当前迭代器++
-            Iterator tmp = *this;
+            IteratorBase tmp = *this;
             ++pos;
             return tmp;
         }
-        Iterator& operator -- (){
+        IteratorBase& operator -- (){
             --pos;
             return *this;
         }
-        Iterator operator -- (int){
-            Iterator tmp = *this;
+        IteratorBase operator -- (int){
+            IteratorBase tmp = *this;
             --pos;
             return tmp;
         }
-        bool operator == (const Iterator & other) const{
+        IteratorBase& operator += (difference_type n){
+            pos += n;
+            return *this;
+        }
+        IteratorBase& operator -= (difference_type n){
+            pos -= n;
+            return *this;
+        }
+        friend IteratorBase operator + (IteratorBase it, difference_type n){
+            return it += n;
+        }
+        friend IteratorBase operator + (difference_type n, IteratorBase it){
+            return it += n;
+        }
+        friend IteratorBase operator - (IteratorBase it, difference_type n){
+            return it -= n;
+        }
+        friend difference_type operator - (const IteratorBase & lhs, const IteratorBase & rhs){
+            return static_cast<difference_type>(lhs.pos) - static_cast<difference_type>(rhs.pos);
+        }
+        bool operator == (const IteratorBase & other) const{
             return (deque_ptr == other.deque_ptr) && (pos == other.pos);
         }
-        bool operator != (const Iterator & other) const{
+        bool operator != (const IteratorBase & other) const{
             return !(*this == other);
         }
+        bool operator < (const IteratorBase & other) const{
+            return pos < other.pos;
+        }
+        bool operator > (const IteratorBase & other) const{
+            return other < *this;
+        }
+        bool operator <= (const IteratorBase & other) const{
+            return !(other < *this);
+        }
+        bool operator >= (const IteratorBase & other) const{
+            return !(*this < other);
+        }
     };
+    using Iterator = IteratorBase<false>;
+    using ConstIterator = IteratorBase<true>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
 
     Iterator begin(){
         return Iterator(this, 0);
@@ -147,6 +301,18 @@ public:
     Iterator end(){
         return Iterator(this, count);
     }
+    ConstIterator begin() const{
+        return ConstIterator(this, 0);
+    }
+    ConstIterator end() const{
+        return ConstIterator(this, count);
+    }
+    ConstIterator cbegin() const{
+        return ConstIterator(this, 0);
+    }
+    ConstIterator cend() const{
+        return ConstIterator(this, count);
+    }
 };
 
 
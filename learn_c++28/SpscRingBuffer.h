@@ -0,0 +1,145 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___SPSCRINGBUFFER_H
+#define LEARNC___SPSCRINGBUFFER_H
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// 单生产者/单消费者无锁环形缓冲区
+// 沿用 Deque 的 front_idx/back_idx 设计：生产者只写 back_idx，消费者只写 front_idx。
+// 两个下标单调递增，不做取模，元素个数 = back_idx - front_idx，真实位置 = 下标 & mask。
+template <typename T>
+class SpscRingBuffer {
+private:
+    static constexpr std::size_t cache_line = 64;
+
+    T * buffer;
+    std::size_t capacity_;
+    std::size_t mask;
+
+    // 消费者侧：front_idx 由消费者发布，cached_back 是消费者看到的 back_idx 缓存
+    alignas(cache_line) std::atomic<std::size_t> front_idx;
+    std::size_t cached_back;
+    // 生产者侧：back_idx 由生产者发布，cached_front 是生产者看到的 front_idx 缓存
+    alignas(cache_line) std::atomic<std::size_t> back_idx;
+    std::size_t cached_front;
+    // 把尾部补齐到一整条缓存行，避免与相邻对象伪共享
+    char padding[cache_line - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+
+    static std::size_t round_up_pow2(std::size_t n){
+        std::size_t cap = 1;
+        while(cap < n){
+            cap <<= 1;
+        }
+        return cap;
+    }
+public:
+    // 容量向上取整为 2 的幂，用位与代替取模
+    explicit SpscRingBuffer(std::size_t capacity = 1024) :
+        capacity_(round_up_pow2(capacity < 2 ? 2 : capacity)), mask(capacity_ - 1),
+        front_idx(0), cached_back(0), back_idx(0), cached_front(0){
+        buffer = new T[capacity_]();
+    }
+    ~SpscRingBuffer(){
+        delete[] buffer;
+    }
+    SpscRingBuffer(const SpscRingBuffer & other) = delete;
+    SpscRingBuffer & operator = (const SpscRingBuffer & other) = delete;
+
+    // ---------- 生产者线程调用 ----------
+    bool try_push(const T & value){
+        return emplace_one(value);
+    }
+    bool try_push(T && value){
+        return emplace_one(std::move(value));
+    }
+    // 批量写入最多 n 个元素，只做一次 release 发布，返回实际写入个数
+    std::size_t try_push_n(const T * src, std::size_t n){
+        std::size_t back = back_idx.load(std::memory_order_relaxed);
+        std::size_t free_slots = capacity_ - (back - cached_front);
+        if(free_slots < n){
+            cached_front = front_idx.load(std::memory_order_acquire);
+            free_slots = capacity_ - (back - cached_front);
+        }
+        if(n > free_slots){
+            n = free_slots;
+        }
+        for(std::size_t i = 0; i < n; ++i){
+            buffer[(back + i) & mask] = src[i];
+        }
+        if(n > 0){
+            back_idx.store(back + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // ---------- 消费者线程调用 ----------
+    bool try_pop(T & out){
+        std::size_t front = front_idx.load(std::memory_order_relaxed);
+        if(front == cached_back){
+            cached_back = back_idx.load(std::memory_order_acquire);
+            if(front == cached_back){
+                return false;
+            }
+        }
+        out = std::move(buffer[front & mask]);
+        front_idx.store(front + 1, std::memory_order_release);
+        return true;
+    }
+    // 批量读出最多 n 个元素，只做一次 release 发布，返回实际读出个数
+    std::size_t try_pop_n(T * dst, std::size_t n){
+        std::size_t front = front_idx.load(std::memory_order_relaxed);
+        std::size_t available = cached_back - front;
+        if(available < n){
+            cached_back = back_idx.load(std::memory_order_acquire);
+            available = cached_back - front;
+        }
+        if(n > available){
+            n = available;
+        }
+        for(std::size_t i = 0; i < n; ++i){
+            dst[i] = std::move(buffer[(front + i) & mask]);
+        }
+        if(n > 0){
+            front_idx.store(front + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // ---------- 任意线程调用，结果只是近似值 ----------
+    // 先读 front 再读 back：back 只增不减且始终不小于 front，差值不会回绕成一个巨大的数；
+    // 两次读取之间消费者又取走了元素时差值可能超过容量，截断到 capacity
+    [[nodiscard]] std::size_t size() const{
+        std::size_t front = front_idx.load(std::memory_order_acquire);
+        std::size_t back = back_idx.load(std::memory_order_acquire);
+        std::size_t count = back - front;
+        return count < capacity_ ? count : capacity_;
+    }
+    bool empty() const{
+        return size() == 0;
+    }
+    [[nodiscard]] std::size_t capacity() const{
+        return capacity_;
+    }
+
+private:
+    template <typename U>
+    bool emplace_one(U && value){
+        std::size_t back = back_idx.load(std::memory_order_relaxed);
+        if(back - cached_front == capacity_){
+            cached_front = front_idx.load(std::memory_order_acquire);
+            if(back - cached_front == capacity_){
+                return false;
+            }
+        }
+        buffer[back & mask] = std::forward<U>(value);
+        back_idx.store(back + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+
+#endif //LEARNC___SPSCRINGBUFFER_H
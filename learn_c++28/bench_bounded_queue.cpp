@@ -0,0 +1,65 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// BoundedQueue 吞吐量测试：不同生产者/消费者数量组合
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdlib>
+#include "BoundedQueue.h"
+
+static double run(int producers, int consumers, std::size_t capacity, long long total){
+    BoundedQueue<long long> queue(capacity);
+    std::atomic<long long> consumed(0);
+    long long per_producer = total / producers;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for(int c = 0; c < consumers; ++c){
+        threads.emplace_back([&queue, &consumed](){
+            long long value;
+            long long local = 0;
+            while(queue.pop(value)){
+                ++local;
+            }
+            consumed += local;
+        });
+    }
+    std::vector<std::thread> producer_threads;
+    for(int p = 0; p < producers; ++p){
+        producer_threads.emplace_back([&queue, per_producer](){
+            for(long long i = 0; i < per_producer; ++i){
+                queue.push(i);
+            }
+        });
+    }
+    for(auto & t : producer_threads){
+        t.join();
+    }
+    queue.close();
+    for(auto & t : threads){
+        t.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(consumed.load()) / seconds / 1e6;
+}
+
+int main(int argc, char * argv[]){
+    long long total = argc > 1 ? std::atoll(argv[1]) : 2000000;
+    std::size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+    const int counts[] = {1, 2, 4, 8};
+    std::cout << "items = " << total << ", capacity = " << capacity << std::endl;
+    std::cout << "producers consumers   Mops/s" << std::endl;
+    for(int p : counts){
+        for(int c : counts){
+            std::cout << std::setw(9) << p << std::setw(10) << c
+                      << std::setw(9) << std::fixed << std::setprecision(2)
+                      << run(p, c, capacity, total) << std::endl;
+        }
+    }
+    return 0;
+}
@@ -3,7 +3,11 @@
 //
 #include <iostream>
 #include <deque>
+#include <thread>
+#include <algorithm>
 #include "Deque.h"
+#include "SpscRingBuffer.h"
+#include "BoundedQueue.h"
 
 int main(){
     Deque<std::string> dq;
@@ -19,6 +23,75 @@ int main(){
         std::cout << *it << std::endl;
     }
 
+    std::cout << "-----------" << std::endl;
+    // 随机访问迭代器：可以直接排序和二分查找
+    Deque<int> timestamps;
+    for(int t : {30, 10, 50, 20, 40}){
+        timestamps.push_back(t);
+    }
+    std::sort(timestamps.begin(), timestamps.end());
+    const Deque<int> & sorted = timestamps;
+    auto pos = std::lower_bound(sorted.cbegin(), sorted.cend(), 35);
+    std::cout << "first >= 35 : " << *pos << " at index " << (pos - sorted.cbegin())
+              << ", timestamps[0] = " << sorted[0] << std::endl;
+
+    std::cout << "-----------" << std::endl;
+    // 连续段访问：回绕后内容分成两段，可以整段交给 write 之类的批量接口
+    Deque<char> bytes(8);
+    const char header[] = "abcdef";
+    bytes.copy_in(header, 6);
+    bytes.pop_front_n(4);
+    const char tail[] = "ghijk";
+    bytes.copy_in(tail, 5);
+    auto [head_seg, tail_seg] = bytes.segments();
+    std::cout << "segments: " << head_seg.size() << " + " << tail_seg.size() << " -> ";
+    std::cout.write(head_seg.data(), static_cast<std::streamsize>(head_seg.size()));
+    std::cout.write(tail_seg.data(), static_cast<std::streamsize>(tail_seg.size()));
+    char out[16];
+    size_t copied = bytes.copy_out(out, sizeof(out));
+    std::cout << " | copy_out " << copied << " bytes: " << std::string(out, copied) << std::endl;
+
+    std::cout << "-----------" << std::endl;
+    // I/O 线程批量写入，工作线程批量读出
+    SpscRingBuffer<int> ring(256);
+    const int total = 100000;
+    std::thread producer([&ring](){
+        int batch[32];
+        int next = 0;
+        while(next < total){
+            int n = 0;
+            while(n < 32 && next + n < total){
+                batch[n] = next + n;
+                ++n;
+            }
+            next += static_cast<int>(ring.try_push_n(batch, n));
+        }
+    });
+    long long sum = 0;
+    int received = 0;
+    int batch[32];
+    while(received < total){
+        size_t n = ring.try_pop_n(batch, 32);
+        for(size_t i = 0; i < n; ++i){
+            sum += batch[i];
+        }
+        received += static_cast<int>(n);
+    }
+    producer.join();
+    std::cout << "received " << received << " items, sum = " << sum << std::endl;
+
+    std::cout << "-----------" << std::endl;
+    // 有界队列：满了之后丢弃最旧的元素，关闭后消费者取完剩余元素即退出
+    BoundedQueue<std::string> queue(2, OverflowPolicy::DropOldest);
+    queue.push("first");
+    queue.push("second");
+    queue.push("third");
+    queue.close();
+    std::cout << "dropped: " << queue.dropped() << ", push after close: " << queue.push("fourth") << std::endl;
+    std::string item;
+    while(queue.pop(item)){
+        std::cout << item << std::endl;
+    }
 
     return 0;
 }
\ No newline at end of file
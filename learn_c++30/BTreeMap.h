@@ -0,0 +1,386 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___BTREEMAP_H
+#define LEARNC___BTREEMAP_H
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+// B+ 树有序映射，接口与 MyMap 保持一致（insert/find/erase/有序 Iterator）
+// 每个节点按 NodeBytes 字节（默认 4 条缓存行）存放尽可能多的键，
+// 一次缓存未命中可以比较很多个键，树高也远低于二叉树。
+// 所有键值对都存放在叶子节点中，叶子之间用双向链表相连，用于顺序遍历。
+// 要求 Key 和 T 可默认构造、可拷贝/移动。
+template <typename Key, typename T, std::size_t NodeBytes = 256>
+class BTreeMap {
+private:
+    static constexpr std::size_t cache_line = 64;
+    static constexpr std::size_t max_of(std::size_t a, std::size_t b){
+        return a > b ? a : b;
+    }
+    // 叶子容量和内部节点容量（键的个数）
+    static constexpr std::size_t leaf_capacity = max_of(4, NodeBytes / (sizeof(Key) + sizeof(T)));
+    static constexpr std::size_t inner_capacity = max_of(4, NodeBytes / (sizeof(Key) + sizeof(void *)));
+    static constexpr std::size_t leaf_min = leaf_capacity / 2;
+    static constexpr std::size_t inner_min = inner_capacity / 2;
+
+    struct alignas(cache_line) Node{
+        bool is_leaf;
+        std::size_t count; // 节点中键的个数
+        explicit Node(bool leaf) : is_leaf(leaf), count(0){}
+    };
+    struct LeafNode : Node{
+        Key keys[leaf_capacity];
+        T values[leaf_capacity];
+        LeafNode * prev;
+        LeafNode * next;
+        LeafNode() : Node(true), keys(), values(), prev(nullptr), next(nullptr){}
+    };
+    // 内部节点：children[i] 中的键都在 [keys[i-1], keys[i]) 之间
+    struct InnerNode : Node{
+        Key keys[inner_capacity];
+        Node * children[inner_capacity + 1];
+        InnerNode() : Node(false), keys(), children(){}
+    };
+    // 子节点分裂后需要插入父节点的分隔键和新的右兄弟
+    struct Split{
+        bool happened;
+        Key separator;
+        Node * right;
+    };
+
+public:
+    BTreeMap() : root(nullptr), node_count(0){}
+    ~BTreeMap(){
+        clear();
+    }
+    BTreeMap(const BTreeMap & other) = delete;
+    BTreeMap & operator = (const BTreeMap & other) = delete;
+
+    void clear(){
+        destroy(root);
+        root = nullptr;
+        node_count = 0;
+    }
+    [[nodiscard]] std::size_t size() const{
+        return node_count;
+    }
+    bool empty() const{
+        return node_count == 0;
+    }
+
+    // 插入键值对，键已存在时覆盖旧值
+    void insert(const Key & key, const T & value){
+        if(root == nullptr){
+            root = new LeafNode();
+        }
+        Split split = insert(root, key, value);
+        if(split.happened){
+            // 根节点分裂，树长高一层
+            auto * new_root = new InnerNode();
+            new_root->keys[0] = split.separator;
+            new_root->children[0] = root;
+            new_root->children[1] = split.right;
+            new_root->count = 1;
+            root = new_root;
+        }
+    }
+    // 查找键，返回指向值的指针，不存在时返回 nullptr
+    T * find(const Key & key) const{
+        if(root == nullptr){
+            return nullptr;
+        }
+        Node * node = root;
+        while(!node->is_leaf){
+            auto * inner = static_cast<InnerNode *>(node);
+            node = inner->children[child_index(inner, key)];
+        }
+        auto * leaf = static_cast<LeafNode *>(node);
+        std::size_t pos = lower_index(leaf, key);
+        if(pos < leaf->count && !(key < leaf->keys[pos])){
+            return &leaf->values[pos];
+        }
+        return nullptr;
+    }
+    void erase(const Key & key){
+        if(root == nullptr || !erase(root, key)){
+            return;
+        }
+        --node_count;
+        // 根节点只剩一个孩子时，树降低一层
+        if(!root->is_leaf && root->count == 0){
+            auto * old_root = static_cast<InnerNode *>(root);
+            root = old_root->children[0];
+            delete old_root;
+        } else if(root->is_leaf && root->count == 0){
+            delete static_cast<LeafNode *>(root);
+            root = nullptr;
+        }
+    }
+
+    // 顺序迭代器，沿叶子链表前进。插入和删除会使所有迭代器失效
+    class Iterator{
+    public:
+        using reference = std::pair<const Key &, T &>;
+        // operator-> 需要返回指针，用一个临时的 pair 代理
+        struct ArrowProxy{
+            reference ref;
+            reference * operator -> (){return &ref;}
+        };
+        Iterator(LeafNode * leaf, std::size_t index) : leaf(leaf), index(index){}
+        reference operator * () const {return reference(leaf->keys[index], leaf->values[index]);}
+        ArrowProxy operator -> () const {return ArrowProxy{**this};}
+        bool operator == (const Iterator & other) const {return leaf == other.leaf && index == other.index;}
+        bool operator != (const Iterator & other) const {return !(*this == other);}
+        Iterator & operator ++ (){
+            if(leaf != nullptr && ++index == leaf->count){
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+        Iterator operator ++ (int){
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+    private:
+        LeafNode * leaf;
+        std::size_t index;
+    };
+    Iterator begin() const{
+        if(root == nullptr){
+            return end();
+        }
+        Node * node = root;
+        while(!node->is_leaf){
+            node = static_cast<InnerNode *>(node)->children[0];
+        }
+        return Iterator(static_cast<LeafNode *>(node), 0);
+    }
+    Iterator end() const{
+        return Iterator(nullptr, 0);
+    }
+
+private:
+    Node * root;
+    std::size_t node_count;
+
+    // 叶子中第一个 >= key 的位置
+    static std::size_t lower_index(const LeafNode * leaf, const Key & key){
+        return std::lower_bound(leaf->keys, leaf->keys + leaf->count, key) - leaf->keys;
+    }
+    // key 所在子树的下标：第一个 > key 的分隔键的位置
+    static std::size_t child_index(const InnerNode * inner, const Key & key){
+        return std::upper_bound(inner->keys, inner->keys + inner->count, key) - inner->keys;
+    }
+
+    void destroy(Node * node){
+        if(node == nullptr) return;
+        if(node->is_leaf){
+            delete static_cast<LeafNode *>(node);
+            return;
+        }
+        auto * inner = static_cast<InnerNode *>(node);
+        for(std::size_t i = 0; i <= inner->count; ++i){
+            destroy(inner->children[i]);
+        }
+        delete inner;
+    }
+
+    Split insert(Node * node, const Key & key, const T & value){
+        if(node->is_leaf){
+            return insert_leaf(static_cast<LeafNode *>(node), key, value);
+        }
+        auto * inner = static_cast<InnerNode *>(node);
+        std::size_t i = child_index(inner, key);
+        Split child_split = insert(inner->children[i], key, value);
+        if(!child_split.happened){
+            return child_split;
+        }
+        return insert_inner(inner, i, child_split.separator, child_split.right);
+    }
+    Split insert_leaf(LeafNode * leaf, const Key & key, const T & value){
+        std::size_t pos = lower_index(leaf, key);
+        if(pos < leaf->count && !(key < leaf->keys[pos])){
+            leaf->values[pos] = value;
+            return Split{false, Key(), nullptr};
+        }
+        ++node_count;
+        if(leaf->count < leaf_capacity){
+            leaf_insert_at(leaf, pos, key, value);
+            return Split{false, Key(), nullptr};
+        }
+        // 叶子已满：后一半移到新叶子，分隔键取新叶子的第一个键（复制上移）
+        auto * right = new LeafNode();
+        std::size_t half = leaf_capacity / 2;
+        std::move(leaf->keys + half, leaf->keys + leaf->count, right->keys);
+        std::move(leaf->values + half, leaf->values + leaf->count, right->values);
+        right->count = leaf->count - half;
+        leaf->count = half;
+        right->next = leaf->next;
+        if(right->next != nullptr){
+            right->next->prev = right;
+        }
+        right->prev = leaf;
+        leaf->next = right;
+        if(pos <= half){
+            leaf_insert_at(leaf, pos, key, value);
+        } else {
+            leaf_insert_at(right, pos - half, key, value);
+        }
+        return Split{true, right->keys[0], right};
+    }
+    static void leaf_insert_at(LeafNode * leaf, std::size_t pos, const Key & key, const T & value){
+        std::move_backward(leaf->keys + pos, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        std::move_backward(leaf->values + pos, leaf->values + leaf->count, leaf->values + leaf->count + 1);
+        leaf->keys[pos] = key;
+        leaf->values[pos] = value;
+        ++leaf->count;
+    }
+    // 孩子 i 分裂出 right，把 separator 插入到 keys[i]，right 插入到 children[i + 1]
+    Split insert_inner(InnerNode * inner, std::size_t i, const Key & separator, Node * right){
+        if(inner->count < inner_capacity){
+            inner_insert_at(inner, i, separator, right);
+            return Split{false, Key(), nullptr};
+        }
+        // 内部节点已满：中间的键上移到父节点，不在左右两边保留
+        auto * sibling = new InnerNode();
+        std::size_t mid = inner_capacity / 2;
+        Key promoted = inner->keys[mid];
+        std::move(inner->keys + mid + 1, inner->keys + inner->count, sibling->keys);
+        std::copy(inner->children + mid + 1, inner->children + inner->count + 1, sibling->children);
+        sibling->count = inner->count - mid - 1;
+        inner->count = mid;
+        if(i <= mid){
+            inner_insert_at(inner, i, separator, right);
+        } else {
+            inner_insert_at(sibling, i - mid - 1, separator, right);
+        }
+        return Split{true, promoted, sibling};
+    }
+    static void inner_insert_at(InnerNode * inner, std::size_t i, const Key & separator, Node * right){
+        std::move_backward(inner->keys + i, inner->keys + inner->count, inner->keys + inner->count + 1);
+        std::copy_backward(inner->children + i + 1, inner->children + inner->count + 1,
+                           inner->children + inner->count + 2);
+        inner->keys[i] = separator;
+        inner->children[i + 1] = right;
+        ++inner->count;
+    }
+
+    // 删除成功返回 true，回溯时由父节点修复下溢的孩子
+    bool erase(Node * node, const Key & key){
+        if(node->is_leaf){
+            auto * leaf = static_cast<LeafNode *>(node);
+            std::size_t pos = lower_index(leaf, key);
+            if(pos == leaf->count || key < leaf->keys[pos]){
+                return false;
+            }
+            std::move(leaf->keys + pos + 1, leaf->keys + leaf->count, leaf->keys + pos);
+            std::move(leaf->values + pos + 1, leaf->values + leaf->count, leaf->values + pos);
+            --leaf->count;
+            return true;
+        }
+        auto * inner = static_cast<InnerNode *>(node);
+        std::size_t i = child_index(inner, key);
+        if(!erase(inner->children[i], key)){
+            return false;
+        }
+        Node * child = inner->children[i];
+        if(child->is_leaf ? child->count < leaf_min : child->count < inner_min){
+            fix_underflow(inner, i);
+        }
+        return true;
+    }
+    // 孩子 i 键数不足：优先向左右兄弟借一个，借不到就与兄弟合并
+    void fix_underflow(InnerNode * parent, std::size_t i){
+        Node * child = parent->children[i];
+        Node * left = i > 0 ? parent->children[i - 1] : nullptr;
+        Node * right = i < parent->count ? parent->children[i + 1] : nullptr;
+        if(child->is_leaf){
+            auto * leaf = static_cast<LeafNode *>(child);
+            auto * left_leaf = static_cast<LeafNode *>(left);
+            auto * right_leaf = static_cast<LeafNode *>(right);
+            if(left_leaf != nullptr && left_leaf->count > leaf_min){
+                std::size_t last = left_leaf->count - 1;
+                leaf_insert_at(leaf, 0, left_leaf->keys[last], left_leaf->values[last]);
+                --left_leaf->count;
+                parent->keys[i - 1] = leaf->keys[0];
+            } else if(right_leaf != nullptr && right_leaf->count > leaf_min){
+                leaf->keys[leaf->count] = std::move(right_leaf->keys[0]);
+                leaf->values[leaf->count] = std::move(right_leaf->values[0]);
+                ++leaf->count;
+                std::move(right_leaf->keys + 1, right_leaf->keys + right_leaf->count, right_leaf->keys);
+                std::move(right_leaf->values + 1, right_leaf->values + right_leaf->count, right_leaf->values);
+                --right_leaf->count;
+                parent->keys[i] = right_leaf->keys[0];
+            } else if(left_leaf != nullptr){
+                merge_leaves(parent, i - 1);
+            } else {
+                merge_leaves(parent, i);
+            }
+            return;
+        }
+        auto * inner = static_cast<InnerNode *>(child);
+        auto * left_inner = static_cast<InnerNode *>(left);
+        auto * right_inner = static_cast<InnerNode *>(right);
+        if(left_inner != nullptr && left_inner->count > inner_min){
+            // 父节点的分隔键下移到 inner 最前面，左兄弟的最后一个键上移到父节点
+            std::move_backward(inner->keys, inner->keys + inner->count, inner->keys + inner->count + 1);
+            std::copy_backward(inner->children, inner->children + inner->count + 1,
+                               inner->children + inner->count + 2);
+            inner->keys[0] = parent->keys[i - 1];
+            inner->children[0] = left_inner->children[left_inner->count];
+            ++inner->count;
+            parent->keys[i - 1] = left_inner->keys[left_inner->count - 1];
+            --left_inner->count;
+        } else if(right_inner != nullptr && right_inner->count > inner_min){
+            inner->keys[inner->count] = parent->keys[i];
+            inner->children[inner->count + 1] = right_inner->children[0];
+            ++inner->count;
+            parent->keys[i] = right_inner->keys[0];
+            std::move(right_inner->keys + 1, right_inner->keys + right_inner->count, right_inner->keys);
+            std::copy(right_inner->children + 1, right_inner->children + right_inner->count + 1,
+                      right_inner->children);
+            --right_inner->count;
+        } else if(left_inner != nullptr){
+            merge_inners(parent, i - 1);
+        } else {
+            merge_inners(parent, i);
+        }
+    }
+    // 把孩子 i + 1 合并进孩子 i，并从父节点删去分隔键 keys[i]
+    static void remove_from_parent(InnerNode * parent, std::size_t i){
+        std::move(parent->keys + i + 1, parent->keys + parent->count, parent->keys + i);
+        std::copy(parent->children + i + 2, parent->children + parent->count + 1, parent->children + i + 1);
+        --parent->count;
+    }
+    static void merge_leaves(InnerNode * parent, std::size_t i){
+        auto * left = static_cast<LeafNode *>(parent->children[i]);
+        auto * right = static_cast<LeafNode *>(parent->children[i + 1]);
+        std::move(right->keys, right->keys + right->count, left->keys + left->count);
+        std::move(right->values, right->values + right->count, left->values + left->count);
+        left->count += right->count;
+        left->next = right->next;
+        if(left->next != nullptr){
+            left->next->prev = left;
+        }
+        delete right;
+        remove_from_parent(parent, i);
+    }
+    static void merge_inners(InnerNode * parent, std::size_t i){
+        auto * left = static_cast<InnerNode *>(parent->children[i]);
+        auto * right = static_cast<InnerNode *>(parent->children[i + 1]);
+        left->keys[left->count] = parent->keys[i];
+        std::move(right->keys, right->keys + right->count, left->keys + left->count + 1);
+        std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+        left->count += right->count + 1;
+        delete right;
+        remove_from_parent(parent, i);
+    }
+};
+
+
+#endif //LEARNC___BTREEMAP_H
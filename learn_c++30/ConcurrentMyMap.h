@@ -0,0 +1,85 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___CONCURRENTMYMAP_H
+#define LEARNC___CONCURRENTMYMAP_H
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "MyMap.h"
+#include "EpochDomain.h"
+
+// 读多写少的并发 MyMap（RCU 风格）
+// 读：登记纪元后直接读取当前版本，不加锁，读者之间只写各自的缓存行，吞吐量随线程数线性增长。
+// 写：持写锁复制出新版本（有序遍历 + bulk_load，O(n)），修改后用原子指针发布，
+//     等旧版本的读者全部离开后再释放旧版本。适合每分钟更新几次的配置表、路由表。
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class ConcurrentMyMap {
+public:
+    using map_type = MyMap<Key, T, Compare>;
+
+    ConcurrentMyMap() : current(new map_type()){}
+    ~ConcurrentMyMap(){
+        delete current.load(std::memory_order_acquire);
+    }
+    ConcurrentMyMap(const ConcurrentMyMap & other) = delete;
+    ConcurrentMyMap & operator = (const ConcurrentMyMap & other) = delete;
+
+    // 在读区内对当前版本执行 fn(const map_type &)，fn 中不能保存指向该版本的指针或迭代器
+    // fn 中不能调用 update/insert/erase：发布后要等所有读者离开，包括本线程，会死锁
+    template <typename Fn>
+    decltype(auto) read(Fn && fn) const{
+        EpochGuard guard;
+        return std::forward<Fn>(fn)(*static_cast<const map_type *>(current.load(std::memory_order_seq_cst)));
+    }
+    // 返回值的拷贝，读区结束后仍然有效
+    std::optional<T> find(const Key & key) const{
+        return read([&key](const map_type & map) -> std::optional<T>{
+            if(auto * node = map.find(key)){
+                return node->data.second;
+            }
+            return std::nullopt;
+        });
+    }
+    [[nodiscard]] std::size_t size() const{
+        return read([](const map_type & map){ return map.size(); });
+    }
+
+    // 在新版本上执行 fn(map_type &)，一次提交多个修改只复制一次
+    template <typename Fn>
+    void update(Fn && fn){
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        map_type * old_map = current.load(std::memory_order_relaxed);
+        // 发布之前新版本由 unique_ptr 持有，复制、bulk_load 或 fn 抛出异常时自动释放
+        auto new_map = std::make_unique<map_type>();
+        std::vector<std::pair<Key, T>> items;
+        items.reserve(old_map->size());
+        for(auto it = old_map->begin(); it != old_map->end(); ++it){
+            items.emplace_back(it->first, it->second);
+        }
+        new_map->bulk_load(items.begin(), items.end());
+        std::forward<Fn>(fn)(*new_map);
+        current.store(new_map.release(), std::memory_order_seq_cst);
+        EpochDomain::instance().synchronize();
+        delete old_map;
+    }
+    void insert(const Key & key, const T & value){
+        update([&](map_type & map){ map.insert(key, value); });
+    }
+    void erase(const Key & key){
+        update([&](map_type & map){ map.erase(key); });
+    }
+
+private:
+    std::atomic<map_type *> current;
+    std::mutex writer_mutex;
+};
+
+
+#endif //LEARNC___CONCURRENTMYMAP_H
@@ -0,0 +1,116 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___EPOCHDOMAIN_H
+#define LEARNC___EPOCHDOMAIN_H
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+// 基于纪元（epoch）的读者登记表，进程内所有并发容器共用一份
+// 每个读线程第一次读时领取一个独占缓存行的槽位，进入读区时写入当前纪元，离开时写回 0。
+// 写者发布新版本后把全局纪元加一，等到所有槽位都为 0 或已大于旧纪元，
+// 说明再没有读者可能持有旧版本，这时才释放旧版本。
+class EpochDomain {
+public:
+    static constexpr std::size_t max_readers = 1024;
+
+    static EpochDomain & instance(){
+        static EpochDomain domain;
+        return domain;
+    }
+    // 进入读区，支持同一线程嵌套
+    void enter(){
+        std::size_t & depth = reader_depth();
+        if(depth == 0){
+            // 领取槽位可能抛出异常，成功之后才增加层数
+            Slot & slot = slots[registration().index];
+            slot.epoch.store(global_epoch.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+            // 与 synchronize 中的栅栏配对：槽位的写入必须先于之后对共享数据的读取被写者看到，
+            // 否则读者可能读到旧版本，写者却还看到槽位为 0，提前释放了旧版本
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ++depth;
+    }
+    void leave(){
+        if(--reader_depth() == 0){
+            slots[registration().index].epoch.store(0, std::memory_order_release);
+        }
+    }
+    // 写者调用：推进纪元，并等待所有在推进之前进入读区的读者离开
+    // 会等待调用线程自己的槽位，因此不能在读区内调用（例如在 for_each/read 的回调里修改容器），
+    // 否则永远等不到自己离开
+    void synchronize(){
+        assert(reader_depth() == 0 && "EpochDomain::synchronize called inside a read section");
+        std::uint64_t old_epoch = global_epoch.fetch_add(1, std::memory_order_seq_cst);
+        // 与 enter 中的栅栏配对：发布新版本（或摘下节点）的写入先于下面对槽位的读取
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        for(auto & slot : slots){
+            while(true){
+                std::uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+                if(epoch == 0 || epoch > old_epoch){
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    struct alignas(64) Slot{
+        std::atomic<std::uint64_t> epoch{0}; // 0 表示不在读区
+        std::atomic<bool> in_use{false};
+    };
+    // 线程退出时归还槽位
+    struct Registration{
+        std::size_t index;
+        Registration() : index(EpochDomain::instance().claim()){}
+        ~Registration(){
+            EpochDomain::instance().slots[index].in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    Slot slots[max_readers];
+    std::atomic<std::uint64_t> global_epoch{1};
+
+    EpochDomain() = default;
+    static Registration & registration(){
+        thread_local Registration reg;
+        return reg;
+    }
+    // 当前线程的读区嵌套层数，单独存放，写者检查它时不必领取槽位
+    static std::size_t & reader_depth(){
+        thread_local std::size_t depth = 0;
+        return depth;
+    }
+    std::size_t claim(){
+        for(std::size_t i = 0; i < max_readers; ++i){
+            bool expected = false;
+            if(!slots[i].in_use.load(std::memory_order_relaxed) &&
+               slots[i].in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)){
+                return i;
+            }
+        }
+        throw std::runtime_error("EpochDomain: too many reader threads");
+    }
+};
+
+// 读区的 RAII 包装，构造时进入、析构时离开
+class EpochGuard {
+public:
+    EpochGuard(){
+        EpochDomain::instance().enter();
+    }
+    ~EpochGuard(){
+        EpochDomain::instance().leave();
+    }
+    EpochGuard(const EpochGuard & other) = delete;
+    EpochGuard & operator = (const EpochGuard & other) = delete;
+};
+
+
+#endif //LEARNC___EPOCHDOMAIN_H
@@ -0,0 +1,295 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___FLATHASHMAP_H
+#define LEARNC___FLATHASHMAP_H
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 开放寻址哈希表，接口与 MyMap 的 insert/find/erase 一致，但不保证遍历顺序
+// 布局：
+// 1. slots 是一整块连续数组，直接存放 std::pair<const Key, T>，没有每个元素一个节点
+// 2. ctrl 是与 slots 一一对应的控制字节：空 / 已删除 / 已占用（低 7 位存哈希的一部分）
+// 3. 控制字节每 16 个为一组，查找时一次比较一整组（有 SSE2 时用一条指令完成），
+//    只有控制字节匹配的槽位才会去比较键
+// 探测方式为按组线性探测，遇到含空槽的组即可停止。
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class FlatHashMap {
+private:
+    // 键为 const，与 MyMap 相同：通过迭代器只能修改值，改键会让元素落在错误的探测位置上
+    using slot_type = std::pair<const Key, T>;
+    static constexpr std::size_t group_width = 16;
+    static constexpr int8_t ctrl_empty = -128;  // 0b10000000
+    static constexpr int8_t ctrl_deleted = -2;  // 0b11111110
+    // 已占用的槽位控制字节为 0~127，即哈希值的低 7 位（h2）
+
+    // 一组控制字节，返回匹配位置的位掩码（第 i 位为 1 表示第 i 个槽位匹配）
+    struct Group{
+        const int8_t * ctrl;
+        uint32_t match(int8_t h2) const{
+#if defined(__SSE2__)
+            __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2))));
+#else
+            uint32_t mask = 0;
+            for(std::size_t i = 0; i < group_width; ++i){
+                mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+            }
+            return mask;
+#endif
+        }
+        uint32_t match_empty() const{
+            return match(ctrl_empty);
+        }
+        // 空槽或已删除的槽位（最高位为 1）
+        uint32_t match_empty_or_deleted() const{
+#if defined(__SSE2__)
+            __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+            return static_cast<uint32_t>(_mm_movemask_epi8(group));
+#else
+            uint32_t mask = 0;
+            for(std::size_t i = 0; i < group_width; ++i){
+                mask |= static_cast<uint32_t>(ctrl[i] < 0) << i;
+            }
+            return mask;
+#endif
+        }
+    };
+    static unsigned lowest_bit(uint32_t mask){
+        return static_cast<unsigned>(std::countr_zero(mask));
+    }
+
+public:
+    explicit FlatHashMap(const Hash & hash = Hash()) :
+        ctrl(nullptr), slots(nullptr), capacity(0), node_count(0), growth_left(0), hasher(hash){}
+    ~FlatHashMap(){
+        destroy_all();
+        deallocate(ctrl, slots, capacity);
+    }
+    FlatHashMap(const FlatHashMap & other) = delete;
+    FlatHashMap & operator = (const FlatHashMap & other) = delete;
+
+    [[nodiscard]] std::size_t size() const{
+        return node_count;
+    }
+    bool empty() const{
+        return node_count == 0;
+    }
+    void clear(){
+        destroy_all();
+        if(capacity > 0){
+            std::memset(ctrl, ctrl_empty, capacity);
+        }
+        node_count = 0;
+        growth_left = max_load(capacity);
+    }
+    // 预留空间，保证插入 n 个元素之前不再扩容
+    void reserve(std::size_t n){
+        std::size_t needed = group_width;
+        while(max_load(needed) < n){
+            needed *= 2;
+        }
+        if(needed > capacity){
+            rehash(needed);
+        }
+    }
+
+    // 插入键值对，键已存在时覆盖旧值
+    void insert(const Key & key, const T & value){
+        std::size_t hash = mix(hasher(key));
+        if(slot_type * slot = find_slot(key, hash)){
+            slot->second = value;
+            return;
+        }
+        new(prepare_insert(hash)) slot_type(key, value);
+    }
+    // 查找键，返回指向值的指针，不存在时返回 nullptr
+    T * find(const Key & key) const{
+        slot_type * slot = find_slot(key, mix(hasher(key)));
+        return slot == nullptr ? nullptr : &slot->second;
+    }
+    void erase(const Key & key){
+        slot_type * slot = find_slot(key, mix(hasher(key)));
+        if(slot == nullptr){
+            return;
+        }
+        std::size_t index = slot - slots;
+        slot->~slot_type();
+        --node_count;
+        // 所在组还有空槽说明没有探测序列越过这个组，可以直接置为空；
+        // 否则必须留下“已删除”标记，保证后面的元素还能被找到
+        Group group{ctrl + (index & ~(group_width - 1))};
+        if(group.match_empty() != 0){
+            ctrl[index] = ctrl_empty;
+            ++growth_left;
+        } else {
+            ctrl[index] = ctrl_deleted;
+        }
+    }
+
+    // 无序迭代器，按槽位顺序跳过空槽。插入可能引起扩容，使所有迭代器失效
+    class Iterator{
+    public:
+        Iterator(const FlatHashMap * map, std::size_t index) : map(map), index(index){
+            skip_empty();
+        }
+        slot_type & operator * () const {return map->slots[index];}
+        slot_type * operator -> () const {return &map->slots[index];}
+        bool operator == (const Iterator & other) const {return index == other.index;}
+        bool operator != (const Iterator & other) const {return !(*this == other);}
+        Iterator & operator ++ (){
+            ++index;
+            skip_empty();
+            return *this;
+        }
+        Iterator operator ++ (int){
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+    private:
+        const FlatHashMap * map;
+        std::size_t index;
+        void skip_empty(){
+            while(index < map->capacity && map->ctrl[index] < 0){
+                ++index;
+            }
+        }
+    };
+    Iterator begin() const{
+        return Iterator(this, 0);
+    }
+    Iterator end() const{
+        return Iterator(this, capacity);
+    }
+
+private:
+    int8_t * ctrl;
+    slot_type * slots;
+    std::size_t capacity; // 槽位个数，2 的幂且不小于 group_width
+    std::size_t node_count;
+    std::size_t growth_left; // 还能放入多少个元素才需要扩容（已删除标记也占额度）
+    Hash hasher;
+
+    // 最大负载因子 7/8
+    static std::size_t max_load(std::size_t cap){
+        return cap - cap / 8;
+    }
+    // 对用户哈希再做一次混合：std::hash 对整数通常是恒等映射，直接用会让高低位分布很差
+    static std::size_t mix(std::size_t hash){
+        uint64_t h = hash;
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 33;
+        h *= 0xC4CEB9FE1A85EC53ull;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+    // 高位决定起始组（h1），低 7 位存进控制字节（h2）
+    static std::size_t h1(std::size_t hash){
+        return hash >> 7;
+    }
+    static int8_t h2(std::size_t hash){
+        return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    slot_type * find_slot(const Key & key, std::size_t hash) const{
+        if(capacity == 0){
+            return nullptr;
+        }
+        std::size_t group_mask = capacity / group_width - 1;
+        std::size_t group_index = h1(hash) & group_mask;
+        int8_t tag = h2(hash);
+        for(std::size_t probes = 0; probes <= group_mask; ++probes){
+            std::size_t base = group_index * group_width;
+            Group group{ctrl + base};
+            for(uint32_t mask = group.match(tag); mask != 0; mask &= mask - 1){
+                std::size_t index = base + lowest_bit(mask);
+                if(slots[index].first == key){
+                    return slots + index;
+                }
+            }
+            if(group.match_empty() != 0){
+                return nullptr;
+            }
+            group_index = (group_index + 1) & group_mask;
+        }
+        return nullptr;
+    }
+    // 为一个确定不存在的键找到空位并写好控制字节，返回未构造的槽位
+    slot_type * prepare_insert(std::size_t hash){
+        if(growth_left == 0){
+            // 已删除标记太多时按原容量重建即可，否则容量翻倍
+            rehash(node_count * 2 < max_load(capacity) ? capacity : (capacity == 0 ? group_width : capacity * 2));
+        }
+        std::size_t index = find_free(hash);
+        if(ctrl[index] == ctrl_empty){
+            --growth_left;
+        }
+        ctrl[index] = h2(hash);
+        ++node_count;
+        return slots + index;
+    }
+    std::size_t find_free(std::size_t hash) const{
+        std::size_t group_mask = capacity / group_width - 1;
+        std::size_t group_index = h1(hash) & group_mask;
+        while(true){
+            std::size_t base = group_index * group_width;
+            uint32_t mask = Group{ctrl + base}.match_empty_or_deleted();
+            if(mask != 0){
+                return base + lowest_bit(mask);
+            }
+            group_index = (group_index + 1) & group_mask;
+        }
+    }
+    void rehash(std::size_t new_capacity){
+        int8_t * old_ctrl = ctrl;
+        slot_type * old_slots = slots;
+        std::size_t old_capacity = capacity;
+
+        ctrl = static_cast<int8_t *>(::operator new(new_capacity, std::align_val_t(group_width)));
+        slots = static_cast<slot_type *>(::operator new(new_capacity * sizeof(slot_type), std::align_val_t(alignof(slot_type))));
+        std::memset(ctrl, ctrl_empty, new_capacity);
+        capacity = new_capacity;
+        growth_left = max_load(new_capacity) - node_count;
+        for(std::size_t i = 0; i < old_capacity; ++i){
+            if(old_ctrl[i] >= 0){
+                std::size_t hash = mix(hasher(old_slots[i].first));
+                std::size_t index = find_free(hash);
+                ctrl[index] = h2(hash);
+                new(slots + index) slot_type(std::move(old_slots[i]));
+                old_slots[i].~slot_type();
+            }
+        }
+        deallocate(old_ctrl, old_slots, old_capacity);
+    }
+    void destroy_all(){
+        if constexpr (!std::is_trivially_destructible_v<slot_type>){
+            for(std::size_t i = 0; i < capacity; ++i){
+                if(ctrl[i] >= 0){
+                    slots[i].~slot_type();
+                }
+            }
+        }
+    }
+    static void deallocate(int8_t * ctrl_bytes, slot_type * slot_array, std::size_t cap){
+        if(cap == 0){
+            return;
+        }
+        ::operator delete(ctrl_bytes, std::align_val_t(group_width));
+        ::operator delete(slot_array, std::align_val_t(alignof(slot_type)));
+    }
+};
+
+
+#endif //LEARNC___FLATHASHMAP_H
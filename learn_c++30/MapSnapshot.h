@@ -0,0 +1,254 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___MAPSNAPSHOT_H
+#define LEARNC___MAPSNAPSHOT_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#if defined(_WIN32)
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "MyMap.h"
+
+// MyMap 的二进制快照
+// 文件布局（小端，本机格式，不跨平台）：
+// [SnapshotHeader，补齐到 64 字节][count 个 Key，按序排列][补齐到 64 字节][count 个 T，与键一一对应]
+// 键和值分开存放：二分查找只会碰到键所在的页，值只在命中时读取一次。
+// 只支持平凡可拷贝的 Key 和 T（整数、浮点、定长结构体等）。
+struct SnapshotHeader{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t key_size;
+    std::uint32_t value_size;
+    std::uint32_t reserved;
+    std::uint64_t count;
+    std::uint64_t values_offset;
+};
+
+inline constexpr char snapshot_magic[8] = {'M', 'Y', 'M', 'A', 'P', 'S', 'N', 'P'};
+inline constexpr std::uint32_t snapshot_version = 1;
+inline constexpr std::size_t snapshot_alignment = 64;
+static_assert(sizeof(SnapshotHeader) <= snapshot_alignment);
+
+// 把 map 按键的顺序写入 path，失败时抛出 std::runtime_error
+template <typename Key, typename T, typename Compare, typename Alloc>
+void save_snapshot(const MyMap<Key, T, Compare, Alloc> & map, const std::string & path){
+    static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>,
+                  "snapshot requires trivially copyable Key and T");
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if(!out){
+        throw std::runtime_error("save_snapshot: cannot open " + path);
+    }
+    std::uint64_t keys_end = snapshot_alignment + map.size() * sizeof(Key);
+    SnapshotHeader header{};
+    std::memcpy(header.magic, snapshot_magic, sizeof(header.magic));
+    header.version = snapshot_version;
+    header.key_size = sizeof(Key);
+    header.value_size = sizeof(T);
+    header.count = map.size();
+    header.values_offset = (keys_end + snapshot_alignment - 1) / snapshot_alignment * snapshot_alignment;
+    const char zeros[snapshot_alignment] = {};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(zeros, snapshot_alignment - sizeof(header));
+    for(auto it = map.begin(); it != map.end(); ++it){
+        out.write(reinterpret_cast<const char *>(&it->first), sizeof(Key));
+    }
+    out.write(zeros, static_cast<std::streamsize>(header.values_offset - keys_end));
+    for(auto it = map.begin(); it != map.end(); ++it){
+        out.write(reinterpret_cast<const char *>(&it->second), sizeof(T));
+    }
+    if(!out.flush()){
+        throw std::runtime_error("save_snapshot: write failed for " + path);
+    }
+}
+
+// 只读的快照索引：把文件映射进内存后直接在页面上二分查找，不重建任何节点
+// 打开只需要 mmap 和校验文件头，真正访问到的页才会被读入。
+// 文件里不记录比较器，Compare 必须与 save_snapshot 时 MyMap 使用的比较器给出相同的顺序，
+// 否则查找结果不正确（二分查找不会越界，但可能找不到已有的键）。
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class MappedSnapshot {
+public:
+    explicit MappedSnapshot(const std::string & path, const Compare & compare = Compare()) :
+        data(nullptr), length(0), keys(nullptr), values(nullptr), count(0), comp(compare){
+        static_assert(std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>,
+                      "snapshot requires trivially copyable Key and T");
+        map_file(path);
+        if(length < snapshot_alignment){
+            unmap();
+            throw std::runtime_error("MappedSnapshot: file too small: " + path);
+        }
+        SnapshotHeader header;
+        std::memcpy(&header, data, sizeof(header));
+        // 先确认 values_offset 落在文件内，再用除法检查 count，
+        // 避免损坏或伪造的 count 在乘法中溢出后通过校验，导致越界读取映射页
+        if(std::memcmp(header.magic, snapshot_magic, sizeof(header.magic)) != 0 ||
+           header.version != snapshot_version || header.key_size != sizeof(Key) ||
+           header.value_size != sizeof(T) ||
+           header.values_offset < snapshot_alignment || header.values_offset > length ||
+           header.values_offset % snapshot_alignment != 0 ||
+           header.count > (header.values_offset - snapshot_alignment) / sizeof(Key) ||
+           header.count > (length - header.values_offset) / sizeof(T)){
+            unmap();
+            throw std::runtime_error("MappedSnapshot: bad snapshot file: " + path);
+        }
+        count = static_cast<std::size_t>(header.count);
+        keys = reinterpret_cast<const Key *>(data + snapshot_alignment);
+        values = reinterpret_cast<const T *>(data + header.values_offset);
+    }
+    ~MappedSnapshot(){
+        unmap();
+    }
+    MappedSnapshot(const MappedSnapshot & other) = delete;
+    MappedSnapshot & operator = (const MappedSnapshot & other) = delete;
+
+    [[nodiscard]] std::size_t size() const{
+        return count;
+    }
+    bool empty() const{
+        return count == 0;
+    }
+    // 查找键，返回指向映射页中值的指针，不存在时返回 nullptr
+    const T * find(const Key & key) const{
+        std::size_t pos = lower_index(key);
+        if(pos < count && !comp(key, keys[pos])){
+            return values + pos;
+        }
+        return nullptr;
+    }
+
+    class Iterator{
+    public:
+        using reference = std::pair<const Key &, const T &>;
+        struct ArrowProxy{
+            reference ref;
+            reference * operator -> (){return &ref;}
+        };
+        Iterator(const MappedSnapshot * snapshot, std::size_t index) : snapshot(snapshot), index(index){}
+        reference operator * () const {return reference(snapshot->keys[index], snapshot->values[index]);}
+        ArrowProxy operator -> () const {return ArrowProxy{**this};}
+        bool operator == (const Iterator & other) const {return index == other.index;}
+        bool operator != (const Iterator & other) const {return !(*this == other);}
+        Iterator & operator ++ (){
+            ++index;
+            return *this;
+        }
+        Iterator operator ++ (int){
+            Iterator tmp = *this;
+            ++index;
+            return tmp;
+        }
+    private:
+        const MappedSnapshot * snapshot;
+        std::size_t index;
+    };
+    Iterator begin() const{
+        return Iterator(this, 0);
+    }
+    Iterator end() const{
+        return Iterator(this, count);
+    }
+    Iterator lower_bound(const Key & key) const{
+        return Iterator(this, lower_index(key));
+    }
+    Iterator upper_bound(const Key & key) const{
+        return Iterator(this, static_cast<std::size_t>(std::upper_bound(keys, keys + count, key, comp) - keys));
+    }
+
+    class Range{
+    public:
+        Range(Iterator first, Iterator last) : first(first), last(last){}
+        Iterator begin() const {return first;}
+        Iterator end() const {return last;}
+    private:
+        Iterator first;
+        Iterator last;
+    };
+    // 键在 [low, high) 之间的所有元素
+    Range range(const Key & low, const Key & high) const{
+        if(!comp(low, high)){
+            return Range(end(), end());
+        }
+        return Range(lower_bound(low), lower_bound(high));
+    }
+
+private:
+    const char * data;
+    std::size_t length;
+    const Key * keys;
+    const T * values;
+    std::size_t count;
+    Compare comp;
+#if defined(_WIN32)
+    std::vector<char> buffer; // 没有 mmap 时退化为一次性读入
+#endif
+
+    std::size_t lower_index(const Key & key) const{
+        return static_cast<std::size_t>(std::lower_bound(keys, keys + count, key, comp) - keys);
+    }
+
+#if defined(_WIN32)
+    void map_file(const std::string & path){
+        std::ifstream in(path, std::ios::binary);
+        if(!in){
+            throw std::runtime_error("MappedSnapshot: cannot open " + path);
+        }
+        buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data = buffer.data();
+        length = buffer.size();
+    }
+    void unmap(){
+        buffer.clear();
+        data = nullptr;
+        length = 0;
+    }
+#else
+    void map_file(const std::string & path){
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0){
+            throw std::runtime_error("MappedSnapshot: cannot open " + path);
+        }
+        struct stat st{};
+        if(::fstat(fd, &st) != 0){
+            ::close(fd);
+            throw std::runtime_error("MappedSnapshot: cannot stat " + path);
+        }
+        length = static_cast<std::size_t>(st.st_size);
+        if(length > 0){
+            void * mapped = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            if(mapped == MAP_FAILED){
+                ::close(fd);
+                throw std::runtime_error("MappedSnapshot: mmap failed for " + path);
+            }
+            data = static_cast<const char *>(mapped);
+        }
+        // 映射建立后文件描述符就可以关闭了
+        ::close(fd);
+    }
+    void unmap(){
+        if(data != nullptr){
+            ::munmap(const_cast<char *>(data), length);
+        }
+        data = nullptr;
+        length = 0;
+    }
+#endif
+};
+
+
+#endif //LEARNC___MAPSNAPSHOT_H
@@ -8,101 +8,105 @@
 #include <utility>
 #include <exception>
 #include <stack>
+#include <new>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include "NodePool.h"
+
+// 红黑树节点颜色
+enum class Color { Red, Black };
 
 template <typename Key, typename T>
 struct TreeNode{
-    std::pair<Key, T> data;
+    // 键为 const，与 std::map 相同：通过迭代器或 find 只能修改值，不会破坏树的有序性
+    std::pair<const Key, T> data;
     TreeNode * left;
     TreeNode * right;
     TreeNode * parent;
+    Color color;
     TreeNode(const Key & key, const T& value, TreeNode * parentNode = nullptr):
-    data(std::make_pair(key, value)), left(nullptr), right(nullptr), parent(parentNode){}
+    data(std::make_pair(key, value)), left(nullptr), right(nullptr), parent(parentNode), color(Color::Red){}
+    // 原地构造：键由 key 构造，值由 args 构造，避免先构造临时对象再拷贝
+    template <typename K, typename... Args>
+    TreeNode(TreeNode * parentNode, K && key, Args&&... args):
+    data(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...)),
+    left(nullptr), right(nullptr), parent(parentNode), color(Color::Red){}
 };
 
-template <typename Key, typename T>
+// 基于红黑树实现，insert/find/erase 最坏情况 O(log n)
+// 红黑树性质：
+// 1. 节点为红色或黑色，根节点为黑色
+// 2. 红色节点的子节点必须是黑色（空节点视为黑色）
+// 3. 从任一节点到其所有空子节点的路径上黑色节点数相同
+// 节点内存由 Alloc 提供，需要有 void * allocate() 和 void deallocate(void *)；
+// 默认使用 NodePool，节点来自连续的 slab。若 Alloc 还提供 release()，clear 时整体释放。
+// Compare 带 is_transparent（如 std::less<>）时，find 等查找接口可以直接接受与 Key 可比较的其他类型，
+// 例如 Key 为 std::string 时用 std::string_view 查找，不必构造临时的 std::string。
+template <typename Key, typename T, typename Compare = std::less<Key>, typename Alloc = NodePool<TreeNode<Key, T>>>
 class MyMap {
 public:
-    MyMap() : root(nullptr){}
+    using node_type = TreeNode<Key, T>;
+    using value_type = std::pair<const Key, T>;
+    using key_compare = Compare;
+    using allocator_type = Alloc;
+
+    MyMap() : root(nullptr), node_count(0), comp(){}
+    explicit MyMap(const Compare & compare) : root(nullptr), node_count(0), comp(compare){}
     ~MyMap(){
         clear();
     }
     void clear(){
-        clear(root);
+        if constexpr (requires(Alloc & a){ a.release(); }){
+            // 节点可以平凡析构时不必遍历，直接把 slab 整体还回去
+            if constexpr (!std::is_trivially_destructible_v<node_type>){
+                dispose_all([](TreeNode<Key, T> * node){ node->~TreeNode(); });
+            }
+            alloc.release();
+        } else {
+            dispose_all([this](TreeNode<Key, T> * node){ destroy_node(node); });
+        }
         root = nullptr;
+        node_count = 0;
     }
     MyMap(const MyMap& other) = delete; // 删去拷贝构造
     MyMap& operator = (const MyMap & other) = delete; // 删去拷贝赋值
+    [[nodiscard]] size_t size() const{
+        return node_count;
+    }
+    bool empty() const{
+        return node_count == 0;
+    }
+    // 插入键值对，键已存在时覆盖旧值
     void insert(const Key& key, const T& value){
-        if(root == nullptr){
-            root = new TreeNode<Key, T>(key, value);
-            return;
-        }
-        TreeNode<Key, T> * current = root;
-        TreeNode<Key, T> * parent = nullptr;
-
-        while(current != nullptr) {
-            parent = current;
-            if(key < current->data.first){
-                current = current->left;
-            } else if (key > current->data.first){
-                current = current->right;
-            } else {
-                current->data.second = value;
-                return;
-            }
-        }
-        if(key < parent->data.first){
-            parent->left = new TreeNode<Key, T>(key, value, parent);
-        } else {
-            parent->right = new TreeNode<Key, T>(key, value, parent);
-        }
+        insert_or_assign(key, value);
+    }
+    // 右值版本：键和值都直接移动进节点
+    void insert(Key&& key, T&& value){
+        insert_or_assign(std::move(key), std::move(value));
     }
     // 删除节点
     void erase(const Key& key){
-        auto * node = find(key);
-        if(node == nullptr) return;
-
-        // 左右子树都不为空
-        if(node->left != nullptr && node->right != nullptr){
-            // 寻找后继节点
-            auto * successor = minimum(node->right);
-            // 替换当前节点值为后记节点
-            node->data = successor->data;
-            // 更新节点为后继节点
-            node = successor;
-        }
-        auto * child = (node->left) ? node->left : node->right;
-        if(child != nullptr) {
-            child->parent = node->parent;
-        }
-        if(node->parent == nullptr){
-            root = child;
-        } else if (node == node->parent->left){
-            node->parent->left = child;
-        } else {
-            node->parent->right = child;
-        }
-        delete node;
+        erase_node(find(key));
+    }
+    template <typename K> requires requires { typename Compare::is_transparent; }
+    void erase(const K& key){
+        erase_node(find(key));
     }
     TreeNode<Key, T> * find(const Key & key) const{
-        auto * current = root;
-        while(current != nullptr){
-            if(key < current->data.first){
-                current = current->left;
-            } else if (key > current->data.first){
-                current = current->right;
-            } else {
-                return current;
-            }
-        }
-        return nullptr;
+        return find_node(key);
+    }
+    // 异构查找，只在 Compare 为透明比较器时可用
+    template <typename K> requires requires { typename Compare::is_transparent; }
+    TreeNode<Key, T> * find(const K & key) const{
+        return find_node(key);
     }
 
     class Iterator{
     public:
         Iterator(TreeNode<Key, T> * node) : current(node){}
-        std::pair<const Key, const T> & operator * () const {return current->data;}
-        std::pair<Key,T> * operator -> () const{return &current->data;}
+        value_type & operator * () const {return current->data;}
+        value_type * operator -> () const{return &current->data;}
         bool operator == (const Iterator& other) const {return current == other.current;}
         bool operator != (const Iterator& other) const {return !(*this == other);}
         Iterator& operator++(){
@@ -145,18 +149,262 @@ public:
         }
     };
     Iterator begin() const{
-        return Iterator(minimum(root));
+        return Iterator(root == nullptr ? nullptr : minimum(root));
     }
     Iterator end() const{
         return Iterator(nullptr);
     }
+
+    // 第一个键 >= key 的位置，Compare 透明时 K 可以是 Key 以外的类型
+    template <typename K = Key> requires (std::is_same_v<K, Key> || requires { typename Compare::is_transparent; })
+    Iterator lower_bound(const K & key) const{
+        TreeNode<Key, T> * current = root;
+        TreeNode<Key, T> * result = nullptr;
+        while(current != nullptr){
+            if(comp(current->data.first, key)){
+                current = current->right;
+            } else {
+                result = current;
+                current = current->left;
+            }
+        }
+        return Iterator(result);
+    }
+    // 第一个键 > key 的位置
+    template <typename K = Key> requires (std::is_same_v<K, Key> || requires { typename Compare::is_transparent; })
+    Iterator upper_bound(const K & key) const{
+        TreeNode<Key, T> * current = root;
+        TreeNode<Key, T> * result = nullptr;
+        while(current != nullptr){
+            if(comp(key, current->data.first)){
+                result = current;
+                current = current->left;
+            } else {
+                current = current->right;
+            }
+        }
+        return Iterator(result);
+    }
+    // 键等于 key 的区间 [lower_bound, upper_bound)
+    template <typename K = Key> requires (std::is_same_v<K, Key> || requires { typename Compare::is_transparent; })
+    std::pair<Iterator, Iterator> equal_range(const K & key) const{
+        return {lower_bound(key), upper_bound(key)};
+    }
+
+    // 一段有序区间，可以直接用于范围 for
+    class Range{
+    public:
+        Range(Iterator first, Iterator last) : first(first), last(last){}
+        Iterator begin() const {return first;}
+        Iterator end() const {return last;}
+    private:
+        Iterator first;
+        Iterator last;
+    };
+    // 键在 [low, high) 之间的所有元素，定位起点 O(log n)，之后每步均摊 O(1)
+    template <typename K = Key> requires (std::is_same_v<K, Key> || requires { typename Compare::is_transparent; })
+    Range range(const K & low, const K & high) const{
+        if(!comp(low, high)){
+            return Range(end(), end());
+        }
+        return Range(lower_bound(low), lower_bound(high));
+    }
+
+    // 键不存在时才用 args 原地构造值；键已存在时什么都不做，args 不会被移动
+    template <typename... Args>
+    std::pair<Iterator, bool> try_emplace(const Key & key, Args&&... args){
+        return emplace_unique(key, std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    std::pair<Iterator, bool> try_emplace(Key && key, Args&&... args){
+        return emplace_unique(std::move(key), std::forward<Args>(args)...);
+    }
+    // 行为与 try_emplace 完全相同（键已存在时什么都不构造，args 不会被移动），
+    // 不同于 std::map::emplace 先构造出元素再查找；区别只在于键也可以由其他类型构造：
+    // Compare 透明时直接用 key 查找，确定要插入时才构造 Key
+    template <typename K, typename... Args>
+    std::pair<Iterator, bool> emplace(K && key, Args&&... args){
+        if constexpr (std::is_same_v<std::remove_cvref_t<K>, Key> || requires { typename Compare::is_transparent; }){
+            return emplace_unique(std::forward<K>(key), std::forward<Args>(args)...);
+        } else {
+            return emplace_unique(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+        }
+    }
+    // 键存在时赋值，不存在时插入
+    template <typename K, typename V>
+    std::pair<Iterator, bool> insert_or_assign(K && key, V && value){
+        auto result = emplace_unique(std::forward<K>(key), std::forward<V>(value));
+        if(!result.second){
+            // 没有插入时 value 未被移动过，可以放心再用一次
+            result.first->second = std::forward<V>(value);
+        }
+        return result;
+    }
+
+    // 用按键严格递增排列的 [first, last) 重建整棵树，原有内容会被清空
+    // 每次取中点作为子树的根，O(n) 建出平衡树，不做任何旋转
+    template <typename RandomIt>
+    void bulk_load(RandomIt first, RandomIt last){
+        clear();
+        std::size_t n = static_cast<std::size_t>(last - first);
+        if(n == 0){
+            return;
+        }
+        // 取中点建树时，只有最深一层可能不满；把最深一层染成红色，其余为黑色，
+        // 每条路径上的黑色节点数就相同了
+        std::size_t red_depth = 0;
+        while((std::size_t(2) << red_depth) - 1 < n){
+            ++red_depth;
+        }
+        root = build(first, 0, n, 0, red_depth, nullptr);
+        root->color = Color::Black;
+        node_count = n;
+    }
+    Alloc & get_allocator(){
+        return alloc;
+    }
 private:
     TreeNode<Key, T> * root;
-    void clear(TreeNode<Key, T> * node) {
+    size_t node_count;
+    Alloc alloc;
+
+    [[no_unique_address]] Compare comp;
+
+    // 查找插入位置，键不存在时才分配节点并构造键值
+    template <typename K, typename... Args>
+    std::pair<Iterator, bool> emplace_unique(K && key, Args&&... args){
+        TreeNode<Key, T> * current = root;
+        TreeNode<Key, T> * parent = nullptr;
+        bool go_left = false;
+        while(current != nullptr) {
+            parent = current;
+            if(comp(key, current->data.first)){
+                current = current->left;
+                go_left = true;
+            } else if (comp(current->data.first, key)){
+                current = current->right;
+                go_left = false;
+            } else {
+                return {Iterator(current), false};
+            }
+        }
+        auto * node = create_node(parent, std::forward<K>(key), std::forward<Args>(args)...);
+        if(parent == nullptr){
+            root = node;
+        } else if(go_left){
+            parent->left = node;
+        } else {
+            parent->right = node;
+        }
+        ++node_count;
+        insert_fixup(node);
+        return {Iterator(node), true};
+    }
+    template <typename... Args>
+    TreeNode<Key, T> * create_node(TreeNode<Key, T> * parent, Args&&... args){
+        void * memory = alloc.allocate();
+        try {
+            return new(memory) TreeNode<Key, T>(parent, std::forward<Args>(args)...);
+        } catch (...) {
+            alloc.deallocate(memory);
+            throw;
+        }
+    }
+    void destroy_node(TreeNode<Key, T> * node){
+        node->~TreeNode();
+        alloc.deallocate(node);
+    }
+    void erase_node(TreeNode<Key, T> * node){
         if(node == nullptr) return;
-        clear(node->left);
-        clear(node->right);
-        delete node;
+
+        // child 顶替被摘除的位置，child_parent 记录它的父节点（child 可能为空）
+        TreeNode<Key, T> * child;
+        TreeNode<Key, T> * child_parent;
+        Color removed_color = node->color;
+        if(node->left == nullptr){
+            child = node->right;
+            child_parent = node->parent;
+            transplant(node, node->right);
+        } else if(node->right == nullptr){
+            child = node->left;
+            child_parent = node->parent;
+            transplant(node, node->left);
+        } else {
+            // 左右子树都不为空，用后继节点顶替当前节点（移动节点而不是拷贝数据）
+            auto * successor = minimum(node->right);
+            removed_color = successor->color;
+            child = successor->right;
+            if(successor->parent == node){
+                child_parent = successor;
+            } else {
+                child_parent = successor->parent;
+                transplant(successor, successor->right);
+                successor->right = node->right;
+                successor->right->parent = successor;
+            }
+            transplant(node, successor);
+            successor->left = node->left;
+            successor->left->parent = successor;
+            successor->color = node->color;
+        }
+        destroy_node(node);
+        --node_count;
+        if(removed_color == Color::Black){
+            erase_fixup(child, child_parent);
+        }
+    }
+    template <typename K>
+    TreeNode<Key, T> * find_node(const K & key) const{
+        auto * current = root;
+        while(current != nullptr){
+            if(comp(key, current->data.first)){
+                current = current->left;
+            } else if (comp(current->data.first, key)){
+                current = current->right;
+            } else {
+                return current;
+            }
+        }
+        return nullptr;
+    }
+    template <typename RandomIt>
+    TreeNode<Key, T> * build(RandomIt first, std::size_t low, std::size_t high,
+                             std::size_t depth, std::size_t red_depth, TreeNode<Key, T> * parent){
+        if(low >= high){
+            return nullptr;
+        }
+        std::size_t mid = low + (high - low) / 2;
+        const auto & item = first[mid];
+        TreeNode<Key, T> * node = create_node(parent, item.first, item.second);
+        node->color = depth == red_depth ? Color::Red : Color::Black;
+        node->left = build(first, low, mid, depth + 1, red_depth, node);
+        node->right = build(first, mid + 1, high, depth + 1, red_depth, node);
+        return node;
+    }
+    // 后序遍历整棵树并对每个节点调用 dispose，借助 parent 指针迭代完成：
+    // 不使用递归和辅助栈，额外空间 O(1)，每个节点只被经过常数次，总时间 O(n)
+    template <typename Dispose>
+    void dispose_all(Dispose dispose){
+        TreeNode<Key, T> * node = root;
+        while(node != nullptr){
+            if(node->left != nullptr){
+                node = node->left;
+            } else if(node->right != nullptr){
+                node = node->right;
+            } else {
+                // 叶子：先从父节点摘下，再处理，然后回到父节点
+                TreeNode<Key, T> * parent = node->parent;
+                if(parent != nullptr){
+                    if(parent->left == node){
+                        parent->left = nullptr;
+                    } else {
+                        parent->right = nullptr;
+                    }
+                }
+                dispose(node);
+                node = parent;
+            }
+        }
     }
     // 遍历node节点为根的树(含node节点)，找到最小的节点
     TreeNode<Key, T> * minimum(TreeNode<Key, T> * node) const{
@@ -182,5 +430,165 @@ private:
         }
         return p;
     }
+
+    static Color color_of(TreeNode<Key, T> * node){
+        return node == nullptr ? Color::Black : node->color;
+    }
+    // 左旋：node 的右孩子 r 上升为子树的根，r 原来的左子树挂到 node 的右边
+    void rotate_left(TreeNode<Key, T> * node){
+        auto * r = node->right;
+        node->right = r->left;
+        if(r->left != nullptr){
+            r->left->parent = node;
+        }
+        r->parent = node->parent;
+        if(node->parent == nullptr){
+            root = r;
+        } else if(node == node->parent->left){
+            node->parent->left = r;
+        } else {
+            node->parent->right = r;
+        }
+        r->left = node;
+        node->parent = r;
+    }
+    // 右旋：左旋的镜像
+    void rotate_right(TreeNode<Key, T> * node){
+        auto * l = node->left;
+        node->left = l->right;
+        if(l->right != nullptr){
+            l->right->parent = node;
+        }
+        l->parent = node->parent;
+        if(node->parent == nullptr){
+            root = l;
+        } else if(node == node->parent->right){
+            node->parent->right = l;
+        } else {
+            node->parent->left = l;
+        }
+        l->right = node;
+        node->parent = l;
+    }
+    // 用 replacement 子树替换 node 子树在父节点中的位置
+    void transplant(TreeNode<Key, T> * node, TreeNode<Key, T> * replacement){
+        if(node->parent == nullptr){
+            root = replacement;
+        } else if(node == node->parent->left){
+            node->parent->left = replacement;
+        } else {
+            node->parent->right = replacement;
+        }
+        if(replacement != nullptr){
+            replacement->parent = node->parent;
+        }
+    }
+    // 插入红色节点后，修复可能出现的连续红色节点
+    void insert_fixup(TreeNode<Key, T> * node){
+        while(node != root && node->parent->color == Color::Red){
+            auto * parent = node->parent;
+            auto * grand = parent->parent; // 父节点为红色，一定不是根，所以祖父存在
+            if(parent == grand->left){
+                auto * uncle = grand->right;
+                if(color_of(uncle) == Color::Red){
+                    // 叔叔为红色：父、叔变黑，祖父变红，继续向上检查
+                    parent->color = Color::Black;
+                    uncle->color = Color::Black;
+                    grand->color = Color::Red;
+                    node = grand;
+                } else {
+                    if(node == parent->right){
+                        // 先转成外侧情况
+                        node = parent;
+                        rotate_left(node);
+                        parent = node->parent;
+                    }
+                    parent->color = Color::Black;
+                    grand->color = Color::Red;
+                    rotate_right(grand);
+                }
+            } else {
+                auto * uncle = grand->left;
+                if(color_of(uncle) == Color::Red){
+                    parent->color = Color::Black;
+                    uncle->color = Color::Black;
+                    grand->color = Color::Red;
+                    node = grand;
+                } else {
+                    if(node == parent->left){
+                        node = parent;
+                        rotate_right(node);
+                        parent = node->parent;
+                    }
+                    parent->color = Color::Black;
+                    grand->color = Color::Red;
+                    rotate_left(grand);
+                }
+            }
+        }
+        root->color = Color::Black;
+    }
+    // 删除黑色节点后，node 所在路径少了一个黑色节点，通过旋转和变色补回
+    void erase_fixup(TreeNode<Key, T> * node, TreeNode<Key, T> * parent){
+        while(node != root && color_of(node) == Color::Black){
+            if(node == parent->left){
+                auto * sibling = parent->right;
+                if(color_of(sibling) == Color::Red){
+                    // 兄弟为红色：转成兄弟为黑色的情况
+                    sibling->color = Color::Black;
+                    parent->color = Color::Red;
+                    rotate_left(parent);
+                    sibling = parent->right;
+                }
+                if(color_of(sibling->left) == Color::Black && color_of(sibling->right) == Color::Black){
+                    // 兄弟的两个孩子都是黑色：兄弟变红，问题上移到父节点
+                    sibling->color = Color::Red;
+                    node = parent;
+                    parent = node->parent;
+                } else {
+                    if(color_of(sibling->right) == Color::Black){
+                        // 兄弟的近侧孩子为红色：先转成远侧孩子为红色
+                        sibling->left->color = Color::Black;
+                        sibling->color = Color::Red;
+                        rotate_right(sibling);
+                        sibling = parent->right;
+                    }
+                    sibling->color = parent->color;
+                    parent->color = Color::Black;
+                    sibling->right->color = Color::Black;
+                    rotate_left(parent);
+                    node = root;
+                }
+            } else {
+                auto * sibling = parent->left;
+                if(color_of(sibling) == Color::Red){
+                    sibling->color = Color::Black;
+                    parent->color = Color::Red;
+                    rotate_right(parent);
+                    sibling = parent->left;
+                }
+                if(color_of(sibling->left) == Color::Black && color_of(sibling->right) == Color::Black){
+                    sibling->color = Color::Red;
+                    node = parent;
+                    parent = node->parent;
+                } else {
+                    if(color_of(sibling->left) == Color::Black){
+                        sibling->right->color = Color::Black;
+                        sibling->color = Color::Red;
+                        rotate_left(sibling);
+                        sibling = parent->left;
+                    }
+                    sibling->color = parent->color;
+                    parent->color = Color::Black;
+                    sibling->left->color = Color::Black;
+                    rotate_right(parent);
+                    node = root;
+                }
+            }
+        }
+        if(node != nullptr){
+            node->color = Color::Black;
+        }
+    }
 };
 #endif //LEARNC___MYMAP_H
@@ -0,0 +1,125 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___NODEPOOL_H
+#define LEARNC___NODEPOOL_H
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// 固定大小节点的内存池，思路来自 exercise2 的 MemoryPool：
+// 预先申请一整块内存（slab），空闲槽位串成空闲链表，分配和回收都是 O(1)。
+// 与 MemoryPool 不同的是：
+// 1. 内存不够时会再申请一块更大的 slab，而不是抛出 bad_alloc
+// 2. 空闲链表直接复用槽位本身的内存，不需要额外的 std::stack
+// 3. release() 一次性归还所有 slab，调用前需保证池中对象都已析构
+template <typename Node>
+class NodePool {
+public:
+    explicit NodePool(std::size_t first_slab_nodes = 64) :
+        free_list(nullptr), cursor(nullptr), slab_end(nullptr),
+        next_slab_nodes(first_slab_nodes == 0 ? 1 : first_slab_nodes){}
+    ~NodePool(){
+        release();
+    }
+    NodePool(const NodePool & other) = delete;
+    NodePool & operator = (const NodePool & other) = delete;
+
+    // 返回一块未构造的、能放下一个 Node 的内存
+    void * allocate(){
+        if(free_list != nullptr){
+            Slot * slot = free_list;
+            free_list = slot->next;
+            return slot;
+        }
+        if(cursor == slab_end){
+            add_slab();
+        }
+        return cursor++;
+    }
+    // 归还内存（对象需已析构），放回空闲链表
+    void deallocate(void * ptr){
+        auto * slot = static_cast<Slot *>(ptr);
+        slot->next = free_list;
+        free_list = slot;
+    }
+    // 只有同一个池才能回收彼此分配的节点
+    bool operator==(const NodePool & other) const{
+        return this == &other;
+    }
+    // 一次性释放所有 slab
+    void release(){
+        for(Slot * slab : slabs){
+            ::operator delete(slab, std::align_val_t(alignof(Slot)));
+        }
+        slabs.clear();
+        free_list = nullptr;
+        cursor = nullptr;
+        slab_end = nullptr;
+    }
+
+private:
+    union Slot{
+        Slot * next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+    static constexpr std::size_t max_slab_nodes = 64 * 1024;
+
+    std::vector<Slot *> slabs;
+    Slot * free_list; // 回收的槽位
+    Slot * cursor;    // 当前 slab 中下一个从未使用过的槽位
+    Slot * slab_end;
+    std::size_t next_slab_nodes;
+
+    // slab 大小按 2 倍增长，节点多时 slab 个数保持在很少的水平
+    void add_slab(){
+        auto * slab = static_cast<Slot *>(::operator new(next_slab_nodes * sizeof(Slot), std::align_val_t(alignof(Slot))));
+        slabs.push_back(slab);
+        cursor = slab;
+        slab_end = slab + next_slab_nodes;
+        if(next_slab_nodes < max_slab_nodes){
+            next_slab_nodes *= 2;
+        }
+    }
+};
+
+// 直接使用全局 new/delete 的节点分配器，接口与 NodePool 相同（没有 release）
+template <typename Node>
+class NewDeleteAllocator {
+public:
+    void * allocate(){
+        return ::operator new(sizeof(Node), std::align_val_t(alignof(Node)));
+    }
+    void deallocate(void * ptr){
+        ::operator delete(ptr, std::align_val_t(alignof(Node)));
+    }
+    // 任意两个实例都能回收对方分配的节点
+    bool operator==(const NewDeleteAllocator &) const{
+        return true;
+    }
+};
+
+// 指向一个外部 NodePool 的分配器，多个容器共用同一个池，
+// 节点可以在这些容器之间移动（例如 List::splice），由任何一个容器回收
+// 各分配器的 operator== 表示“能否回收对方分配的节点”，List 据此判断能否在两个链表之间移动节点
+template <typename Pool>
+class NodePoolRef {
+public:
+    explicit NodePoolRef(Pool & pool) : pool(&pool){}
+    void * allocate(){
+        return pool->allocate();
+    }
+    void deallocate(void * ptr){
+        pool->deallocate(ptr);
+    }
+    // 指向同一个池时可以互相回收节点
+    bool operator==(const NodePoolRef & other) const{
+        return pool == other.pool;
+    }
+private:
+    Pool * pool;
+};
+
+
+#endif //LEARNC___NODEPOOL_H
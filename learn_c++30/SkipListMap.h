@@ -0,0 +1,378 @@
+//
+// Created by lyx on 2026/10/19.
+//
+
+#ifndef LEARNC___SKIPLISTMAP_H
+#define LEARNC___SKIPLISTMAP_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "EpochDomain.h"
+
+// 并发有序映射：细粒度加锁的惰性跳表（lazy skip list）
+// 1. 定位不加锁，只沿 next 指针前进；insert 会原地覆盖已有的值，
+//    所以 find/for_each 拷贝值时短暂锁住目标节点这一个锁，拷贝完立即释放
+// 2. 插入/删除只锁住要修改的前驱节点，不同位置的修改可以并行
+// 3. 删除分两步：先打上 marked 标记（逻辑删除），再从各层摘下（物理删除）
+// 4. 被摘下的节点可能仍有读者在访问，借助 EpochDomain 确认没有读者后再批量释放
+// 接口与 MyMap 的 insert/find/erase 和有序 Iterator 保持一致，find 返回值的拷贝。
+template <typename Key, typename T, typename Compare = std::less<Key>>
+class SkipListMap {
+private:
+    static constexpr int max_level = 24;
+    static constexpr std::size_t retire_batch = 64;
+
+    // 节点公共部分，next 指向与节点一起分配的各层后继指针数组
+    struct NodeBase{
+        std::atomic<NodeBase *> * next;
+        int top_level;
+        std::mutex lock;
+        std::atomic<bool> marked;       // 已被逻辑删除
+        std::atomic<bool> fully_linked; // 各层都已链接完成
+        explicit NodeBase(int level) : next(nullptr), top_level(level), marked(false), fully_linked(false){}
+    };
+    struct Node : NodeBase{
+        std::pair<const Key, T> data; // 键为 const，与 MyMap 相同
+        template <typename K, typename V>
+        Node(int level, K && key, V && value) : NodeBase(level), data(std::forward<K>(key), std::forward<V>(value)){}
+    };
+
+public:
+    SkipListMap() : head(create_head()), node_count(0){}
+    ~SkipListMap(){
+        NodeBase * node = head->next[0].load(std::memory_order_relaxed);
+        while(node != nullptr){
+            NodeBase * next = node->next[0].load(std::memory_order_relaxed);
+            destroy_node(static_cast<Node *>(node));
+            node = next;
+        }
+        for(Node * node : retired){
+            destroy_node(node);
+        }
+        head->~NodeBase();
+        ::operator delete(head);
+    }
+    SkipListMap(const SkipListMap & other) = delete;
+    SkipListMap & operator = (const SkipListMap & other) = delete;
+
+    [[nodiscard]] std::size_t size() const{
+        return node_count.load(std::memory_order_relaxed);
+    }
+    bool empty() const{
+        return size() == 0;
+    }
+
+    // 插入键值对，键已存在时覆盖旧值；返回 true 表示新插入
+    bool insert(const Key & key, const T & value){
+        return insert_impl(key, value);
+    }
+    bool insert(Key && key, T && value){
+        return insert_impl(std::move(key), std::move(value));
+    }
+    // 返回值的拷贝，不存在时返回 std::nullopt
+    std::optional<T> find(const Key & key) const{
+        EpochGuard guard;
+        NodeBase * preds[max_level];
+        NodeBase * succs[max_level];
+        int found = find_position(key, preds, succs);
+        if(found == -1){
+            return std::nullopt;
+        }
+        auto * node = static_cast<Node *>(succs[found]);
+        if(!node->fully_linked.load(std::memory_order_acquire)){
+            return std::nullopt;
+        }
+        // 值可能被并发的 insert 覆盖，拷贝时锁住这一个节点
+        std::lock_guard<std::mutex> node_lock(node->lock);
+        if(node->marked.load(std::memory_order_relaxed)){
+            return std::nullopt;
+        }
+        return node->data.second;
+    }
+    bool contains(const Key & key) const{
+        EpochGuard guard;
+        NodeBase * preds[max_level];
+        NodeBase * succs[max_level];
+        int found = find_position(key, preds, succs);
+        return found != -1 && succs[found]->fully_linked.load(std::memory_order_acquire) &&
+               !succs[found]->marked.load(std::memory_order_acquire);
+    }
+    // 删除键，返回 true 表示由本线程删除
+    bool erase(const Key & key){
+        Node * victim = nullptr;
+        {
+            EpochGuard guard;
+            victim = unlink(key);
+        }
+        if(victim == nullptr){
+            return false;
+        }
+        node_count.fetch_sub(1, std::memory_order_relaxed);
+        retire(victim);
+        return true;
+    }
+
+    // 沿最底层有序遍历。迭代器不在读区内，遍历期间不能有并发的 erase；
+    // 需要与删除并发遍历时使用 for_each
+    class Iterator{
+    public:
+        Iterator(NodeBase * node) : current(node){
+            skip_deleted();
+        }
+        std::pair<const Key, T> & operator * () const {return static_cast<Node *>(current)->data;}
+        std::pair<const Key, T> * operator -> () const {return &static_cast<Node *>(current)->data;}
+        bool operator == (const Iterator & other) const {return current == other.current;}
+        bool operator != (const Iterator & other) const {return !(*this == other);}
+        Iterator & operator ++ (){
+            current = current->next[0].load(std::memory_order_acquire);
+            skip_deleted();
+            return *this;
+        }
+        Iterator operator ++ (int){
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+    private:
+        NodeBase * current;
+        void skip_deleted(){
+            while(current != nullptr && (current->marked.load(std::memory_order_acquire) ||
+                                         !current->fully_linked.load(std::memory_order_acquire))){
+                current = current->next[0].load(std::memory_order_acquire);
+            }
+        }
+    };
+    Iterator begin() const{
+        return Iterator(head->next[0].load(std::memory_order_acquire));
+    }
+    Iterator end() const{
+        return Iterator(nullptr);
+    }
+    // 在读区内按键的顺序对每个元素执行 fn(const Key &, const T &)，可以与任意修改并发
+    // 看到的是弱一致的结果：遍历过程中插入或删除的元素可能出现也可能不出现
+    // 值在节点锁内拷贝出来，调用 fn 时不持有任何锁，fn 中可以调用 find/contains/insert；
+    // 但不能调用 erase：回收节点时要等所有读者离开，包括正在 for_each 中的本线程，会死锁
+    template <typename Fn>
+    void for_each(Fn && fn) const{
+        EpochGuard guard;
+        NodeBase * node = head->next[0].load(std::memory_order_acquire);
+        while(node != nullptr){
+            if(node->fully_linked.load(std::memory_order_acquire)){
+                auto * item = static_cast<Node *>(node);
+                std::optional<T> value;
+                {
+                    std::lock_guard<std::mutex> node_lock(item->lock);
+                    if(!item->marked.load(std::memory_order_relaxed)){
+                        value.emplace(item->data.second);
+                    }
+                }
+                // 键插入后不再改变，节点在读区内不会被释放，可以直接引用
+                if(value){
+                    fn(static_cast<const Key &>(item->data.first), static_cast<const T &>(*value));
+                }
+            }
+            node = node->next[0].load(std::memory_order_acquire);
+        }
+    }
+
+private:
+    NodeBase * head;
+    std::atomic<std::size_t> node_count;
+    [[no_unique_address]] Compare comp;
+    std::mutex retire_mutex;
+    std::vector<Node *> retired; // 已摘下、等待释放的节点
+
+    template <typename K, typename V>
+    bool insert_impl(K && key, V && value){
+        EpochGuard guard;
+        int top_level = random_level();
+        NodeBase * preds[max_level];
+        NodeBase * succs[max_level];
+        while(true){
+            int found = find_position(key, preds, succs);
+            if(found != -1){
+                auto * node = static_cast<Node *>(succs[found]);
+                if(!node->marked.load(std::memory_order_acquire)){
+                    // 等待并发的插入者把节点链接完整
+                    while(!node->fully_linked.load(std::memory_order_acquire)){
+                        std::this_thread::yield();
+                    }
+                    std::lock_guard<std::mutex> node_lock(node->lock);
+                    if(!node->marked.load(std::memory_order_relaxed)){
+                        node->data.second = std::forward<V>(value);
+                        return false;
+                    }
+                }
+                // 节点正在被删除，重新查找
+                continue;
+            }
+            std::unique_lock<std::mutex> locks[max_level];
+            if(!lock_and_validate(preds, succs, top_level, locks)){
+                continue;
+            }
+            Node * node = create_node(top_level, std::forward<K>(key), std::forward<V>(value));
+            for(int level = 0; level <= top_level; ++level){
+                node->next[level].store(succs[level], std::memory_order_relaxed);
+            }
+            for(int level = 0; level <= top_level; ++level){
+                preds[level]->next[level].store(node, std::memory_order_release);
+            }
+            node->fully_linked.store(true, std::memory_order_release);
+            node_count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    static NodeBase * create_head(){
+        void * memory = ::operator new(sizeof(NodeBase) + max_level * sizeof(std::atomic<NodeBase *>));
+        auto * node = new(memory) NodeBase(max_level - 1);
+        node->next = reinterpret_cast<std::atomic<NodeBase *> *>(static_cast<char *>(memory) + sizeof(NodeBase));
+        for(int level = 0; level < max_level; ++level){
+            new(&node->next[level]) std::atomic<NodeBase *>(nullptr);
+        }
+        node->fully_linked.store(true, std::memory_order_relaxed);
+        return node;
+    }
+    // 节点和它的 top_level + 1 个后继指针一次分配
+    template <typename K, typename V>
+    static Node * create_node(int top_level, K && key, V && value){
+        std::size_t levels = static_cast<std::size_t>(top_level) + 1;
+        void * memory = ::operator new(sizeof(Node) + levels * sizeof(std::atomic<NodeBase *>));
+        Node * node;
+        try {
+            node = new(memory) Node(top_level, std::forward<K>(key), std::forward<V>(value));
+        } catch (...) {
+            ::operator delete(memory);
+            throw;
+        }
+        node->next = reinterpret_cast<std::atomic<NodeBase *> *>(static_cast<char *>(memory) + sizeof(Node));
+        for(std::size_t level = 0; level < levels; ++level){
+            new(&node->next[level]) std::atomic<NodeBase *>(nullptr);
+        }
+        return node;
+    }
+    static void destroy_node(Node * node){
+        node->~Node();
+        ::operator delete(node);
+    }
+    // 层数服从 p = 1/2 的几何分布
+    static int random_level(){
+        thread_local std::uint64_t state = 0x9E3779B97F4A7C15ull ^
+                                           std::hash<std::thread::id>()(std::this_thread::get_id());
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int level = 0;
+        std::uint64_t bits = state;
+        while((bits & 1) != 0 && level < max_level - 1){
+            ++level;
+            bits >>= 1;
+        }
+        return level;
+    }
+
+    // 记录每一层中 key 的前驱和后继，返回找到 key 的最高层，没找到返回 -1
+    template <typename K>
+    int find_position(const K & key, NodeBase ** preds, NodeBase ** succs) const{
+        int found = -1;
+        NodeBase * pred = head;
+        for(int level = max_level - 1; level >= 0; --level){
+            NodeBase * curr = pred->next[level].load(std::memory_order_acquire);
+            while(curr != nullptr && comp(static_cast<Node *>(curr)->data.first, key)){
+                pred = curr;
+                curr = pred->next[level].load(std::memory_order_acquire);
+            }
+            if(found == -1 && curr != nullptr && !comp(key, static_cast<Node *>(curr)->data.first)){
+                found = level;
+            }
+            preds[level] = pred;
+            succs[level] = curr;
+        }
+        return found;
+    }
+    // 自底向上锁住 0~top_level 层的前驱（同一节点只锁一次），并检查它们仍然相邻且未被删除。
+    // 删除时后继就是已打标记的被删节点，不检查后继的标记
+    static bool lock_and_validate(NodeBase ** preds, NodeBase ** succs, int top_level,
+                                  std::unique_lock<std::mutex> * locks, bool check_succ = true){
+        NodeBase * previous = nullptr;
+        for(int level = 0; level <= top_level; ++level){
+            NodeBase * pred = preds[level];
+            NodeBase * succ = succs[level];
+            if(pred != previous){
+                locks[level] = std::unique_lock<std::mutex>(pred->lock);
+                previous = pred;
+            }
+            if(pred->marked.load(std::memory_order_acquire) ||
+               (check_succ && succ != nullptr && succ->marked.load(std::memory_order_acquire)) ||
+               pred->next[level].load(std::memory_order_acquire) != succ){
+                return false;
+            }
+        }
+        return true;
+    }
+    // 逻辑删除并摘下节点，返回被摘下的节点
+    Node * unlink(const Key & key){
+        NodeBase * preds[max_level];
+        NodeBase * succs[max_level];
+        Node * victim = nullptr;
+        std::unique_lock<std::mutex> victim_lock;
+        while(true){
+            int found = find_position(key, preds, succs);
+            if(victim == nullptr){
+                if(found == -1){
+                    return nullptr;
+                }
+                auto * candidate = static_cast<Node *>(succs[found]);
+                // 只删除完整链接、且在最高层被找到的节点
+                if(!candidate->fully_linked.load(std::memory_order_acquire) || candidate->top_level != found ||
+                   candidate->marked.load(std::memory_order_acquire)){
+                    return nullptr;
+                }
+                victim_lock = std::unique_lock<std::mutex>(candidate->lock);
+                if(candidate->marked.load(std::memory_order_relaxed)){
+                    return nullptr; // 被其他线程抢先删除
+                }
+                candidate->marked.store(true, std::memory_order_release);
+                victim = candidate;
+            }
+            // 被删节点的后继就是它自己，按节点本身验证前驱
+            for(int level = 0; level <= victim->top_level; ++level){
+                succs[level] = victim;
+            }
+            std::unique_lock<std::mutex> locks[max_level];
+            if(!lock_and_validate(preds, succs, victim->top_level, locks, false)){
+                continue;
+            }
+            for(int level = victim->top_level; level >= 0; --level){
+                preds[level]->next[level].store(victim->next[level].load(std::memory_order_relaxed),
+                                                std::memory_order_release);
+            }
+            return victim;
+        }
+    }
+    // 攒够一批再等待读者离开，摊薄 synchronize 的开销
+    void retire(Node * node){
+        std::vector<Node *> batch;
+        {
+            std::lock_guard<std::mutex> lock(retire_mutex);
+            retired.push_back(node);
+            if(retired.size() < retire_batch){
+                return;
+            }
+            batch.swap(retired);
+        }
+        EpochDomain::instance().synchronize();
+        for(Node * item : batch){
+            destroy_node(item);
+        }
+    }
+};
+
+
+#endif //LEARNC___SKIPLISTMAP_H
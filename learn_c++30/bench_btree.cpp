@@ -0,0 +1,80 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// BTreeMap / MyMap / std::map 对比：随机插入、随机查找、顺序遍历
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "MyMap.h"
+#include "BTreeMap.h"
+
+template <typename Fn>
+static double measure_ms(Fn && fn){
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void report(const std::string & name, double insert_ms, double find_ms, double scan_ms){
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << insert_ms << std::setw(12) << find_ms << std::setw(12) << scan_ms << std::endl;
+}
+
+// 三种容器的查找接口返回类型不同，统一取出值
+static long long value_of(TreeNode<long long, long long> * node){ return node->data.second; }
+static long long value_of(long long * value){ return *value; }
+static long long value_of(std::map<long long, long long>::iterator it){ return it->second; }
+
+template <typename Map, typename Insert>
+static void run(const std::string & name, const std::vector<long long> & keys,
+                const std::vector<long long> & probes, Insert insert, long long & checksum){
+    Map map;
+    double insert_ms = measure_ms([&](){
+        for(long long key : keys){
+            insert(map, key);
+        }
+    });
+    double find_ms = measure_ms([&](){
+        for(long long key : probes){
+            checksum += value_of(map.find(key));
+        }
+    });
+    double scan_ms = measure_ms([&](){
+        for(auto it = map.begin(); it != map.end(); ++it){
+            checksum += it->second;
+        }
+    });
+    report(name, insert_ms, find_ms, scan_ms);
+}
+
+int main(int argc, char * argv[]){
+    long long n = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    std::mt19937_64 rng(42);
+    std::vector<long long> keys(n);
+    for(long long i = 0; i < n; ++i){
+        keys[i] = i * 7;
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    std::vector<long long> probes = keys;
+    std::shuffle(probes.begin(), probes.end(), rng);
+
+    long long checksum = 0;
+    std::cout << "random keys, n = " << n << " (ms)" << std::endl;
+    std::cout << std::left << std::setw(10) << "map" << std::right
+              << std::setw(12) << "insert" << std::setw(12) << "find" << std::setw(12) << "scan" << std::endl;
+    run<BTreeMap<long long, long long>>("BTreeMap", keys, probes,
+        [](auto & map, long long key){ map.insert(key, key); }, checksum);
+    run<MyMap<long long, long long>>("MyMap", keys, probes,
+        [](auto & map, long long key){ map.insert(key, key); }, checksum);
+    run<std::map<long long, long long>>("std::map", keys, probes,
+        [](auto & map, long long key){ map.insert({key, key}); }, checksum);
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
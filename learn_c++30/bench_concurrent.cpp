@@ -0,0 +1,101 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// 读多写少场景：ConcurrentMyMap 与“全局互斥锁 + MyMap”的读吞吐量对比
+// 读线程不断随机查找，同时有一个写线程每 10ms 更新一次
+#include <iostream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <string>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "MyMap.h"
+#include "ConcurrentMyMap.h"
+
+struct LockedMap{
+    std::mutex mtx;
+    MyMap<long long, long long> map;
+    long long find(long long key){
+        std::lock_guard<std::mutex> lock(mtx);
+        auto * node = map.find(key);
+        return node ? node->data.second : 0;
+    }
+    void insert(long long key, long long value){
+        std::lock_guard<std::mutex> lock(mtx);
+        map.insert(key, value);
+    }
+};
+
+struct RcuMap{
+    ConcurrentMyMap<long long, long long> map;
+    long long find(long long key){
+        return map.find(key).value_or(0);
+    }
+    void insert(long long key, long long value){
+        map.insert(key, value);
+    }
+};
+
+template <typename Map>
+static double run(Map & map, int readers, long long keys, long long reads_per_thread){
+    std::atomic<bool> done(false);
+    std::thread writer([&](){
+        long long version = 0;
+        while(!done.load()){
+            map.insert(version % keys, version);
+            ++version;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+    std::atomic<long long> checksum(0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for(int t = 0; t < readers; ++t){
+        threads.emplace_back([&, t](){
+            std::mt19937_64 rng(t);
+            long long local = 0;
+            for(long long i = 0; i < reads_per_thread; ++i){
+                local += map.find(static_cast<long long>(rng() % keys));
+            }
+            checksum += local;
+        });
+    }
+    for(auto & t : threads){
+        t.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    done = true;
+    writer.join();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(readers) * static_cast<double>(reads_per_thread) / seconds / 1e6;
+}
+
+int main(int argc, char * argv[]){
+    long long keys = argc > 1 ? std::atoll(argv[1]) : 10000;
+    long long reads = argc > 2 ? std::atoll(argv[2]) : 2000000;
+    LockedMap locked;
+    RcuMap rcu;
+    rcu.map.update([&](auto & map){
+        for(long long i = 0; i < keys; ++i){
+            map.insert(i, i);
+        }
+    });
+    for(long long i = 0; i < keys; ++i){
+        locked.insert(i, i);
+    }
+    unsigned max_threads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3]))
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "keys = " << keys << ", reads per thread = " << reads << " (Mops/s)" << std::endl;
+    std::cout << "readers      mutex        rcu" << std::endl;
+    for(unsigned readers = 1; readers <= max_threads; readers *= 2){
+        std::cout << std::setw(7) << readers << std::fixed << std::setprecision(2)
+                  << std::setw(11) << run(locked, static_cast<int>(readers), keys, reads)
+                  << std::setw(11) << run(rcu, static_cast<int>(readers), keys, reads) << std::endl;
+    }
+    return 0;
+}
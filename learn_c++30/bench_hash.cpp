@@ -0,0 +1,84 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// FlatHashMap / MyMap / std::unordered_map 对比：插入与随机查找，单位 ns/次
+// 用法：learn_c++30_bench_hash [n1 n2 ...]，默认测 1K 和 1M，
+// 100M 需要显式传入 100000000（MyMap 和 std::unordered_map 此时需要十几 GB 内存）
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include "MyMap.h"
+#include "FlatHashMap.h"
+
+template <typename Fn>
+static double measure_ns(Fn && fn){
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+static long long value_of(TreeNode<long long, long long> * node){ return node->data.second; }
+static long long value_of(long long * value){ return *value; }
+static long long value_of(std::unordered_map<long long, long long>::iterator it){ return it->second; }
+
+template <typename Map, typename Insert>
+static void run(const std::string & name, const std::vector<long long> & keys,
+                const std::vector<long long> & probes, Insert insert, long long & checksum){
+    auto * map = new Map();
+    double insert_ns = measure_ns([&](){
+        for(long long key : keys){
+            insert(*map, key);
+        }
+    });
+    double find_ns = measure_ns([&](){
+        for(long long key : probes){
+            checksum += value_of(map->find(key));
+        }
+    });
+    delete map;
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << insert_ns / static_cast<double>(keys.size())
+              << std::setw(12) << find_ns / static_cast<double>(probes.size()) << std::endl;
+}
+
+int main(int argc, char * argv[]){
+    std::vector<long long> sizes;
+    for(int i = 1; i < argc; ++i){
+        sizes.push_back(std::atoll(argv[i]));
+    }
+    if(sizes.empty()){
+        sizes = {1000, 1000000};
+    }
+    long long checksum = 0;
+    std::mt19937_64 rng(42);
+    for(long long n : sizes){
+        std::vector<long long> keys(n);
+        for(long long i = 0; i < n; ++i){
+            keys[i] = static_cast<long long>(rng() >> 1);
+        }
+        // 小规模时重复查找，保证计时足够长
+        std::size_t probe_count = std::max<std::size_t>(keys.size(), 2000000);
+        std::vector<long long> probes(probe_count);
+        for(std::size_t i = 0; i < probe_count; ++i){
+            probes[i] = keys[rng() % keys.size()];
+        }
+        std::cout << "n = " << n << " (ns/op)" << std::endl;
+        std::cout << std::left << std::setw(20) << "map" << std::right
+                  << std::setw(12) << "insert" << std::setw(12) << "find" << std::endl;
+        run<FlatHashMap<long long, long long>>("FlatHashMap", keys, probes,
+            [](auto & map, long long key){ map.insert(key, key); }, checksum);
+        run<MyMap<long long, long long>>("MyMap", keys, probes,
+            [](auto & map, long long key){ map.insert(key, key); }, checksum);
+        run<std::unordered_map<long long, long long>>("std::unordered_map", keys, probes,
+            [](auto & map, long long key){ map.insert({key, key}); }, checksum);
+    }
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
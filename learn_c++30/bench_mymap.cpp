@@ -0,0 +1,157 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// 有序插入场景测试：时间戳、序列号这类单调递增的键
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <random>
+#include <vector>
+#include <cstdio>
+#include "MyMap.h"
+#include "MapSnapshot.h"
+
+template <typename Fn>
+static double measure_ms(Fn && fn){
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+static void report(const std::string & name, double insert_ms, double find_ms, double erase_ms){
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << insert_ms << std::setw(12) << find_ms << std::setw(12) << erase_ms << std::endl;
+}
+
+// 高频增删：窗口内的键不断被插入和删除
+template <typename Map>
+static double churn_ms(long long n, long long & checksum){
+    Map map;
+    std::mt19937_64 rng(7);
+    const long long window = 100000;
+    double ms = measure_ms([&](){
+        for(long long i = 0; i < n; ++i){
+            long long key = static_cast<long long>(rng() % window);
+            if(i & 1){
+                map.erase(key);
+            } else {
+                map.insert(key, i);
+            }
+        }
+        map.clear();
+    });
+    checksum += static_cast<long long>(map.size());
+    return ms;
+}
+
+int main(int argc, char * argv[]){
+    long long n = argc > 1 ? std::atoll(argv[1]) : 1000000;
+    long long checksum = 0;
+    std::cout << "sorted keys, n = " << n << " (ms)" << std::endl;
+    std::cout << std::left << std::setw(10) << "map" << std::right
+              << std::setw(12) << "insert" << std::setw(12) << "find" << std::setw(12) << "erase" << std::endl;
+    {
+        MyMap<long long, long long> my_map;
+        double insert_ms = measure_ms([&](){
+            for(long long i = 0; i < n; ++i){
+                my_map.insert(i, i);
+            }
+        });
+        double find_ms = measure_ms([&](){
+            for(long long i = 0; i < n; ++i){
+                checksum += my_map.find(i)->data.second;
+            }
+        });
+        double erase_ms = measure_ms([&](){
+            for(long long i = 0; i < n; ++i){
+                my_map.erase(i);
+            }
+        });
+        report("MyMap", insert_ms, find_ms, erase_ms);
+    }
+    {
+        std::map<long long, long long> std_map;
+        double insert_ms = measure_ms([&](){
+            for(long long i = 0; i < n; ++i){
+                std_map.insert({i, i});
+            }
+        });
+        double find_ms = measure_ms([&](){
+            for(long long i = 0; i < n; ++i){
+                checksum += std_map.find(i)->second;
+            }
+        });
+        double erase_ms = measure_ms([&](){
+            for(long long i = 0; i < n; ++i){
+                std_map.erase(i);
+            }
+        });
+        report("std::map", insert_ms, find_ms, erase_ms);
+    }
+
+    std::cout << "churn, " << n * 4 << " random insert/erase (ms)" << std::endl;
+    std::cout << std::left << std::setw(24) << "MyMap + NodePool" << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << churn_ms<MyMap<long long, long long>>(n * 4, checksum) << std::endl;
+    std::cout << std::left << std::setw(24) << "MyMap + new/delete" << std::right
+              << std::setw(12) << churn_ms<MyMap<long long, long long, std::less<long long>,
+                      NewDeleteAllocator<TreeNode<long long, long long>>>>(n * 4, checksum) << std::endl;
+
+    // 有序输入直接建树，对比逐个 insert
+    {
+        std::vector<std::pair<long long, long long>> sorted(n);
+        for(long long i = 0; i < n; ++i){
+            sorted[i] = {i, i};
+        }
+        MyMap<long long, long long> my_map;
+        std::cout << "bulk_load " << n << " sorted pairs (ms)" << std::setw(12)
+                  << measure_ms([&](){ my_map.bulk_load(sorted.begin(), sorted.end()); }) << std::endl;
+        // 时间窗口查询：每次定位 O(log n)，只遍历窗口内的元素
+        double range_ms = measure_ms([&](){
+            for(long long start = 0; start + 100 < n; start += 1000){
+                for(auto & item : my_map.range(start, start + 100)){
+                    checksum += item.second;
+                }
+            }
+        });
+        std::cout << "range [t, t + 100) every 1000 keys (ms)" << std::setw(12) << range_ms << std::endl;
+    }
+
+    // 快照：保存后 mmap 打开，不重建节点直接查找
+    {
+        MyMap<long long, long long> my_map;
+        for(long long i = 0; i < n; ++i){
+            my_map.insert(i, i);
+        }
+        const std::string path = "mymap_bench.snapshot";
+        std::cout << "save_snapshot (ms)" << std::setw(12)
+                  << measure_ms([&](){ save_snapshot(my_map, path); }) << std::endl;
+        double open_ms = 0;
+        double find_ms = measure_ms([&](){
+            MappedSnapshot<long long, long long> * snapshot = nullptr;
+            open_ms = measure_ms([&](){ snapshot = new MappedSnapshot<long long, long long>(path); });
+            for(long long i = 0; i < n; ++i){
+                checksum += *snapshot->find(i);
+            }
+            delete snapshot;
+        });
+        std::cout << "open snapshot (ms)" << std::setw(12) << open_ms << std::endl;
+        std::cout << "open + " << n << " finds (ms)" << std::setw(12) << find_ms << std::endl;
+        std::remove(path.c_str());
+    }
+
+    // 析构整棵树：迭代后序遍历，栈空间与 n 无关
+    {
+        MyMap<long long, std::string, std::less<long long>, NewDeleteAllocator<TreeNode<long long, std::string>>> my_map;
+        for(long long i = 0; i < n; ++i){
+            my_map.insert(i, "value");
+        }
+        std::cout << "clear " << n << " string nodes (ms)" << std::setw(12)
+                  << measure_ms([&](){ my_map.clear(); }) << std::endl;
+    }
+    std::cout << "checksum " << checksum << std::endl;
+    return 0;
+}
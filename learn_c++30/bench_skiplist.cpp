@@ -0,0 +1,74 @@
+//
+// Created by lyx on 2026/10/19.
+//
+// 并发有序插入/查找：SkipListMap 与“全局互斥锁 + MyMap”的吞吐量对比
+// 每个线程一半操作插入随机键，一半操作查找随机键
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "MyMap.h"
+#include "SkipListMap.h"
+
+struct LockedMap{
+    std::mutex mtx;
+    MyMap<long long, long long> map;
+    void insert(long long key, long long value){
+        std::lock_guard<std::mutex> lock(mtx);
+        map.insert(key, value);
+    }
+    bool contains(long long key){
+        std::lock_guard<std::mutex> lock(mtx);
+        return map.find(key) != nullptr;
+    }
+};
+
+template <typename Map>
+static double run(int threads, long long ops_per_thread, long long key_range){
+    Map map;
+    std::vector<std::thread> workers;
+    std::vector<long long> hits(threads, 0);
+    auto start = std::chrono::steady_clock::now();
+    for(int t = 0; t < threads; ++t){
+        workers.emplace_back([&, t](){
+            std::mt19937_64 rng(t + 1);
+            long long local = 0;
+            for(long long i = 0; i < ops_per_thread; ++i){
+                long long key = static_cast<long long>(rng() % key_range);
+                if(i & 1){
+                    local += map.contains(key);
+                } else {
+                    map.insert(key, i);
+                }
+            }
+            hits[t] = local;
+        });
+    }
+    for(auto & worker : workers){
+        worker.join();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    return static_cast<double>(threads) * static_cast<double>(ops_per_thread) / seconds / 1e6;
+}
+
+int main(int argc, char * argv[]){
+    long long ops = argc > 1 ? std::atoll(argv[1]) : 500000;
+    long long key_range = argc > 2 ? std::atoll(argv[2]) : 1000000;
+    unsigned max_threads = argc > 3 ? static_cast<unsigned>(std::atoi(argv[3]))
+                                    : std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "ops per thread = " << ops << ", key range = " << key_range << " (Mops/s)" << std::endl;
+    std::cout << "threads   mutex+MyMap   SkipListMap" << std::endl;
+    for(unsigned threads = 1; threads <= max_threads; threads *= 2){
+        std::cout << std::setw(7) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(14) << run<LockedMap>(static_cast<int>(threads), ops, key_range)
+                  << std::setw(14) << run<SkipListMap<long long, long long>>(static_cast<int>(threads), ops, key_range)
+                  << std::endl;
+    }
+    return 0;
+}
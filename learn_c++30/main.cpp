@@ -5,7 +5,16 @@
 #include <string>
 #include <algorithm>
 #include <functional>
+#include <vector>
+#include <string_view>
 #include "MyMap.h"
+#include "BTreeMap.h"
+#include "FlatHashMap.h"
+#include "ConcurrentMyMap.h"
+#include "MapSnapshot.h"
+#include "SkipListMap.h"
+#include <thread>
+#include <cstdio>
 
 int main(){
     MyMap<int, std::string> my_map;
@@ -22,7 +31,90 @@ int main(){
     for(auto it = my_map.begin(); it != my_map.end(); ++it){
         std::cout << it->first << ": " << it->second << std::endl;
     }
+
+    // 区间查询：键在 [140, 170) 之间的元素
+    std::cout << "Range [140, 170):" << std::endl;
+    for(auto & item : my_map.range(140, 170)){
+        std::cout << item.first << ": " << item.second << std::endl;
+    }
+    my_map.clear();
+
+    // 有序数据直接建成平衡树
+    std::vector<std::pair<int, std::string>> sorted = {{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
+    my_map.bulk_load(sorted.begin(), sorted.end());
+    std::cout << "bulk_load size: " << my_map.size() << ", upper_bound(2): " << my_map.upper_bound(2)->first << std::endl;
     my_map.clear();
 
+    // 透明比较器：直接用 string_view 查找，try_emplace 只在键不存在时构造值
+    MyMap<std::string, int, std::less<>> word_count;
+    std::string_view word = "hello";
+    word_count.emplace(word, 1);
+    auto [pos, inserted] = word_count.try_emplace("hello", 100);
+    std::cout << "hello: " << pos->second << ", inserted again: " << inserted
+              << ", find(string_view): " << word_count.find(word)->data.second << std::endl;
+
+    std::cout << "BTreeMap:" << std::endl;
+    BTreeMap<int, std::string> btree;
+    btree.insert(150, "apple");
+    btree.insert(130, "banana");
+    btree.insert(170, "orange");
+    btree.erase(130);
+    if(auto * value = btree.find(170)){
+        std::cout << "find 170: " << *value << std::endl;
+    }
+    for(auto it = btree.begin(); it != btree.end(); ++it){
+        std::cout << it->first << ": " << it->second << std::endl;
+    }
+
+    std::cout << "FlatHashMap:" << std::endl;
+    FlatHashMap<std::string, int> stock;
+    stock.insert("apple", 3);
+    stock.insert("banana", 5);
+    stock.insert("apple", 4);
+    stock.erase("banana");
+    std::cout << "apple: " << *stock.find("apple") << ", banana found: " << (stock.find("banana") != nullptr) << std::endl;
+
+    // 读多写少：读者不加锁，写者整体发布新版本
+    ConcurrentMyMap<std::string, std::string> routes;
+    routes.update([](auto & map){
+        map.insert("/home", "server-a");
+        map.insert("/api", "server-b");
+    });
+    routes.insert("/api", "server-c");
+    std::cout << "/api -> " << routes.find("/api").value_or("none")
+              << ", /admin -> " << routes.find("/admin").value_or("none") << std::endl;
+
+    // 快照：写成有序的二进制文件，mmap 打开后直接查找
+    MyMap<int, double> prices;
+    prices.insert(3, 9.5);
+    prices.insert(1, 2.25);
+    prices.insert(2, 4.0);
+    save_snapshot(prices, "prices.snapshot");
+    {
+        MappedSnapshot<int, double> snapshot("prices.snapshot");
+        std::cout << "snapshot size: " << snapshot.size() << ", price of 2: " << *snapshot.find(2) << std::endl;
+        for(auto item : snapshot.range(2, 4)){
+            std::cout << item.first << ": " << item.second << std::endl;
+        }
+    }
+    std::remove("prices.snapshot");
+
+    // 跳表：多个线程同时插入，遍历结果仍然有序
+    SkipListMap<int, int> skip_list;
+    std::vector<std::thread> writers;
+    for(int t = 0; t < 4; ++t){
+        writers.emplace_back([&skip_list, t](){
+            for(int i = t; i < 40; i += 4){
+                skip_list.insert(i, i * i);
+            }
+        });
+    }
+    for(auto & writer : writers){
+        writer.join();
+    }
+    skip_list.erase(0);
+    std::cout << "skip list size: " << skip_list.size() << ", first: " << skip_list.begin()->first
+              << ", find(6): " << skip_list.find(6).value_or(-1) << std::endl;
+
     return 0;
 }
\ No newline at end of file